@@ -0,0 +1,76 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_AGGREGATE_H
+#define VIKKI_AGENT_AGGREGATE_H
+
+#include "schema.h"
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace vikki
+{
+	std::time_t bucket_start(std::time_t time, std::time_t bucket);
+
+	struct aggregate
+	{
+		uint64_t count;
+		std::vector<char> min;
+		std::vector<char> max;
+		std::vector<char> avg;
+	};
+
+	class aggregator
+	{
+	public:
+		aggregator(const std::vector<value_type>& layout);
+		~aggregator();
+
+		void add(const std::vector<char>& data);
+		void add(const aggregate& value);
+
+		bool empty() const;
+		aggregate result() const;
+
+		void reset();
+
+	private:
+		std::vector<value_type> _layout;
+		size_t _size;
+		uint64_t _count;
+		std::vector<char> _min;
+		std::vector<char> _max;
+		std::vector<double> _sum;
+
+		void add_values(const char *min, const char *max, const char *avg, uint64_t count);
+
+	};
+}
+
+#endif // VIKKI_AGENT_AGGREGATE_H
+
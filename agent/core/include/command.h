@@ -34,7 +34,11 @@ namespace vikki
 		sensor_data_subscribe	= 0x00000000,
 		sensor_data_updated		= 0x00000001,
 		get_sensor_data			= 0x00000002,
-		get_sensor_list			= 0x00000003
+		get_sensor_list			= 0x00000003,
+		get_sensor_aggregated_data	= 0x00000004,
+		get_sensor_schema		= 0x00000005,
+		set_time_resolution		= 0x00000006,
+		get_sensor_list_ex		= 0x00000007
 	};
 }
 
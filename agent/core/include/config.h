@@ -29,8 +29,10 @@ SOFTWARE.
 
 #include "exception.h"
 #include "json.h"
+#include "timestamp.h"
 
 #include <string>
+#include <ctime>
 #include <map>
 #include <list>
 
@@ -50,9 +52,27 @@ namespace vikki
 		{
 			bool active;
 			std::string name;
+			std::string instance;
+			timestamp interval;
+			bool rates;
+			std::time_t window;
+			double percentile;
 			std::map<std::string, std::string> params;
 		};
 
+		struct rollup_tier_info
+		{
+			std::time_t resolution;
+			std::time_t retention;
+		};
+
+		struct rollup_info
+		{
+			bool enabled;
+			std::time_t raw_retention;
+			std::list<rollup_tier_info> tiers;
+		};
+
 		struct network_security_info
 		{
 			bool enable;
@@ -74,15 +94,18 @@ namespace vikki
 		storage_info storage() const;
 		std::list<sensor_info> sensors() const;
 		network_info network() const;
+		rollup_info rollup() const;
 
 	private:
 		network_info _network;
 		storage_info _storage;
 		std::list<sensor_info> _sensors;
+		rollup_info _rollup;
 
 		void load_network_settings(const nlohmann::json& node);
 		void load_storage_settings(const nlohmann::json& node);
 		void load_sensors_settings(const nlohmann::json& node);
+		void load_rollup_settings(const nlohmann::json& node);
 
 	};
 }
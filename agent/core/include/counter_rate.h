@@ -0,0 +1,68 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_COUNTER_RATE_H
+#define VIKKI_AGENT_COUNTER_RATE_H
+
+#include "schema.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace vikki
+{
+	class counter_rate
+	{
+	public:
+		counter_rate(const sensor_schema& schema);
+		~counter_rate();
+
+		bool empty() const;
+		sensor_schema schema() const;
+
+		bool apply(std::vector<char>& data);
+
+	private:
+		struct counter
+		{
+			size_t offset;
+			value_type type;
+			bool wraps;
+			uint64_t previous;
+		};
+
+		sensor_schema _schema;
+		size_t _size;
+		std::vector<counter> _counters;
+		std::chrono::steady_clock::time_point _time;
+		bool _ready;
+
+	};
+}
+
+#endif // VIKKI_AGENT_COUNTER_RATE_H
+
@@ -28,6 +28,9 @@ SOFTWARE.
 #define VIKKI_AGENT_NETWORK_H
 
 #include "storage.h"
+#include "rollup.h"
+#include "schema.h"
+#include "timestamp.h"
 
 #include "network/server.h"
 
@@ -40,7 +43,7 @@ namespace vikki
 	class network
 	{
 	public:
-		network(storage *store);
+		network(storage *store, rollup *rollups);
 		~network();
 
 		void encryption(const std::map<std::string, std::string>& params);
@@ -48,11 +51,16 @@ namespace vikki
 		void start(const std::string& address, int port);
 		void stop();
 
-		void sensor_updated(const std::string& name, std::time_t time, const std::vector<char>& data);
+		void sensor_added(const std::string& name, const std::string& plugin, const sensor_schema& schema);
+		void sensor_updated(const std::string& name, timestamp time, const std::vector<char>& data);
 
 		void sensor_change_subscription(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
 		void sensor_get_data(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
+		void sensor_get_aggregated_data(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
+		void sensor_get_schema(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
 		void sensor_get_list(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
+		void sensor_get_list_ex(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
+		void set_time_resolution(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream);
 
 	private:
 		struct sensor_subscriber
@@ -61,9 +69,22 @@ namespace vikki
 			std::shared_ptr<lnetlib::connection> conn;
 		};
 
+		struct sensor_entry
+		{
+			std::string name;
+			std::string plugin;
+			sensor_schema schema;
+		};
+
 		storage *_storage;
+		rollup *_rollup;
 		lnetlib::server _server;
 		std::vector<sensor_subscriber> _sensor_subscribers;
+		std::vector<sensor_entry> _sensors;
+		std::vector<std::shared_ptr<lnetlib::connection>> _precise_connections;
+
+		const sensor_schema& find_schema(const std::string& name) const;
+		bool is_precise(std::shared_ptr<lnetlib::connection> conn) const;
 
 		void connected(std::shared_ptr<lnetlib::connection> conn);
 		void disconnected(std::shared_ptr<lnetlib::connection> conn);
@@ -0,0 +1,59 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_PARAM_LIST_H
+#define VIKKI_AGENT_PARAM_LIST_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace vikki
+{
+	// comma separated sensor parameter, items are trimmed and empty ones skipped
+	std::vector<std::string> split_param_list(const std::string& value);
+
+	// "include" and "exclude" glob lists of a sensor, an empty include list accepts everything
+	class name_filter
+	{
+	public:
+		explicit name_filter(const std::vector<std::string>& exclude = std::vector<std::string>());
+		~name_filter();
+
+		void init(const std::map<std::string, std::string>& params);
+
+		bool accepted(const char *name) const;
+
+	private:
+		std::vector<std::string> _include;
+		std::vector<std::string> _exclude;
+
+		static bool matches(const std::vector<std::string>& patterns, const char *name);
+
+	};
+}
+
+#endif // VIKKI_AGENT_PARAM_LIST_H
@@ -0,0 +1,66 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_PROCFS_TABLE_H
+#define VIKKI_AGENT_PROCFS_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vikki
+{
+	class procfs_table
+	{
+	public:
+		explicit procfs_table(const std::vector<std::string>& keys, char separator = ':');
+		~procfs_table();
+
+		size_t size() const;
+		const std::string& key(size_t index) const;
+
+		size_t parse(const char *data, size_t size, uint64_t *values) const;
+
+	private:
+		struct entry
+		{
+			std::string key;
+			size_t index;
+		};
+
+		std::vector<std::string> _keys;
+		std::vector<entry> _entries;
+		char _separator;
+
+		const entry* find(const char *key, size_t size) const;
+		uint64_t parse_value(const char *p, const char *end) const;
+
+	};
+}
+
+#endif // VIKKI_AGENT_PROCFS_TABLE_H
+
@@ -0,0 +1,81 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_ROLLUP_H
+#define VIKKI_AGENT_ROLLUP_H
+
+#include "config.h"
+#include "storage.h"
+#include "aggregate.h"
+
+#include <string>
+#include <ctime>
+#include <vector>
+#include <map>
+
+namespace vikki
+{
+	class rollup
+	{
+	public:
+		rollup(storage *store, const config::rollup_info& info);
+		~rollup();
+
+		rollup(const rollup& value) = delete;
+		rollup& operator=(const rollup& value) = delete;
+
+		void prepare_entity(const std::string& sensor_name, const std::vector<value_type>& layout);
+		void prepare_window(const std::string& sensor_name, std::time_t resolution);
+
+		void put_data(const std::string& sensor_name, const std::vector<value_type>& layout, std::time_t time, const std::vector<char>& data);
+		storage::aggregated_data_t get_aggregated_data(const std::string& sensor_name, std::time_t from, std::time_t to,
+			std::time_t& bucket, const std::vector<value_type>& layout);
+
+		void flush();
+		void purge(const std::string& sensor_name, const std::vector<value_type>& layout, std::time_t time);
+
+	private:
+		struct tier_state
+		{
+			std::time_t resolution;
+			std::time_t bucket_time;
+			aggregator data;
+		};
+
+		storage *_storage;
+		bool _enabled;
+		std::time_t _raw_retention;
+		std::vector<config::rollup_tier_info> _tiers;
+		std::map<std::string, std::vector<tier_state>> _states;
+		std::map<std::string, std::time_t> _windows;
+
+		void flush_tier(const std::string& sensor_name, tier_state& state);
+
+	};
+}
+
+#endif // VIKKI_AGENT_ROLLUP_H
+
@@ -0,0 +1,75 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_SAMPLE_WINDOW_H
+#define VIKKI_AGENT_SAMPLE_WINDOW_H
+
+#include "schema.h"
+#include "aggregate.h"
+#include "timestamp.h"
+
+#include <ctime>
+#include <vector>
+
+namespace vikki
+{
+	class sample_window
+	{
+	public:
+		sample_window(const std::vector<value_type>& layout, std::time_t length, double percentile);
+		~sample_window();
+
+		std::time_t length() const;
+		std::time_t start() const;
+
+		bool empty() const;
+		bool expired(timestamp time) const;
+
+		void add(timestamp time, const std::vector<char>& data);
+
+		aggregate result() const;
+		timestamp last_time() const;
+		const std::vector<char>& last() const;
+		std::vector<char> percentile() const;
+
+		void reset();
+
+	private:
+		std::vector<value_type> _layout;
+		size_t _size;
+		std::time_t _length;
+		double _percentile;
+		std::time_t _start;
+		timestamp _last_time;
+		std::vector<char> _last;
+		std::vector<char> _samples;
+		aggregator _data;
+
+	};
+}
+
+#endif // VIKKI_AGENT_SAMPLE_WINDOW_H
+
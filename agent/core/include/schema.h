@@ -0,0 +1,83 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_SCHEMA_H
+#define VIKKI_AGENT_SCHEMA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace vikki
+{
+	enum class value_type : uint8_t
+	{
+		int64	= 0x00,
+		uint64	= 0x01,
+		float64	= 0x02
+	};
+
+	enum class field_kind : uint8_t
+	{
+		gauge		= 0x00,
+		counter		= 0x01,
+		counter32	= 0x02
+	};
+
+	struct sensor_field
+	{
+		std::string name;
+		value_type type;
+		field_kind kind;
+	};
+
+	using sensor_schema = std::vector<sensor_field>;
+
+	size_t value_size(value_type type);
+	size_t layout_size(const std::vector<value_type>& layout);
+
+	std::vector<value_type> schema_layout(const sensor_schema& schema);
+
+	sensor_field parse_sensor_field(const std::string& spec, value_type default_type);
+
+	template<typename Payload>
+	sensor_schema payload_schema()
+	{
+		sensor_schema result;
+
+		for (size_t i = 0; i < Payload::count(); ++i)
+		{
+			result.push_back(sensor_field { Payload::name(i), static_cast<value_type>(Payload::code(i)),
+				static_cast<field_kind>(Payload::kind(i)) });
+		}
+
+		return result;
+	}
+}
+
+#endif // VIKKI_AGENT_SCHEMA_H
+
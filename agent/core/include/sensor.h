@@ -27,6 +27,9 @@ SOFTWARE.
 #ifndef VIKKI_AGENT_SENSOR_H
 #define VIKKI_AGENT_SENSOR_H
 
+#include "schema.h"
+
+#include <cstring>
 #include <string>
 #include <vector>
 #include <map>
@@ -40,7 +43,14 @@ namespace vikki
 		virtual ~sensor();
 
 		virtual std::string name() const = 0;
-		virtual std::vector<char> data() = 0;
+		// each sensor overrides at least one of these, the defaults are implemented via each other
+		virtual std::vector<char> data();
+		virtual size_t sample(char *buffer, size_t capacity);
+		virtual sensor_schema schema() const;
+		// a fixed layout is decoded as is by a dedicated client dashboard, so it can't be rewritten into rates
+		virtual bool fixed_layout() const;
+
+		std::vector<value_type> layout() const;
 
 		virtual void init(const std::map<std::string, std::string>& params);
 
@@ -53,10 +63,8 @@ namespace vikki
 	template<typename T>
 	void sensor::write_data(void *p, T value, void **pp)
 	{
-		T *pT = reinterpret_cast<T*>(p);
-
-		*pT = value;
-		*pp = pT + 1;
+		std::memcpy(p, &value, sizeof(T));
+		*pp = static_cast<char*>(p) + sizeof(T);
 	}
 }
 
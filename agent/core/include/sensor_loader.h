@@ -50,6 +50,7 @@ namespace vikki
 		std::string get_sensor_name(size_t idx) const;
 
 		sensor* get_sensor(const std::string& name) const;
+		sensor* create_sensor(const std::string& name, const std::string& instance_name);
 
 	private:
 		using create_sensor_t = sensor* (*)();
@@ -58,13 +59,21 @@ namespace vikki
 		struct sensor_plugin
 		{
 			void *plugin_handle;
-			sensor *sensor_handle;
+			std::string name;
 			create_sensor_t create_sensor;
 			destroy_sensor_t destroy_sensor;
 		};
 
+		struct sensor_instance
+		{
+			std::string name;
+			sensor *sensor_handle;
+			destroy_sensor_t destroy_sensor;
+		};
+
 		const std::string _path;
 		std::vector<sensor_plugin> _plugins;
+		std::vector<sensor_instance> _instances;
 
 		void load_sensors();
 		void unload_sensors();
@@ -28,14 +28,19 @@ SOFTWARE.
 #define VIKKI_AGENT_SERVICE_H
 
 #include "config.h"
+#include "counter_rate.h"
+#include "sample_window.h"
 #include "sensor_loader.h"
 #include "storage_loader.h"
+#include "rollup.h"
 #include "network.h"
 
 #include "asio/io_service.hpp"
 #include "asio/steady_timer.hpp"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace vikki
 {
@@ -48,9 +53,26 @@ namespace vikki
 		void run();
 
 	private:
+		struct active_sensor
+		{
+			std::string name;
+			sensor *handle;
+			timestamp interval;
+			timestamp deadline;
+			sensor_schema schema;
+			std::vector<value_type> layout;
+			std::vector<char> buffer;
+			std::unique_ptr<counter_rate> rates;
+			std::unique_ptr<sample_window> window;
+			std::string percentile_name;
+		};
+
 		config _config;
 		std::unique_ptr<network> _network;
 		storage *_active_storage;
+		std::unique_ptr<rollup> _rollup;
+		std::time_t _purge_time;
+		std::vector<active_sensor> _sensors;
 
 		void init_storage();
 		void init_sensors();
@@ -59,7 +81,11 @@ namespace vikki
 		asio::io_service _service;
 
 		void timer_tick(asio::steady_timer& timer);
+		void schedule(asio::steady_timer& timer);
 		void update_sensors();
+		void sample_sensor(active_sensor& sens);
+		void flush_window(active_sensor& sens);
+		void purge_storage();
 
 	};
 }
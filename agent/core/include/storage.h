@@ -27,6 +27,9 @@ SOFTWARE.
 #ifndef VIKKI_AGENT_STORAGE_H
 #define VIKKI_AGENT_STORAGE_H
 
+#include "aggregate.h"
+#include "timestamp.h"
+
 #include <string>
 #include <ctime>
 #include <vector>
@@ -37,7 +40,9 @@ namespace vikki
 	class storage
 	{
 	public:
-		using sensor_data_t = std::map<std::time_t, std::vector<char>>;
+		using sensor_data_t = std::map<timestamp, std::vector<char>>;
+		using aggregated_data_t = std::map<std::time_t, aggregate>;
+		using rollup_data_t = std::multimap<std::time_t, aggregate>;
 
 		storage();
 		virtual ~storage();
@@ -47,10 +52,18 @@ namespace vikki
 		virtual void open(const std::map<std::string, std::string>& params) = 0;
 		virtual void close() = 0;
 
-		virtual void put_data(const std::string& sensor_name, std::time_t time, const std::vector<char>& data) = 0;
-		virtual sensor_data_t get_data(const std::string& sensor_name, std::time_t from, std::time_t to) = 0;
+		virtual void put_data(const std::string& sensor_name, timestamp time, const std::vector<char>& data) = 0;
+		virtual sensor_data_t get_data(const std::string& sensor_name, timestamp from, timestamp to) = 0;
+		virtual aggregated_data_t get_aggregated_data(const std::string& sensor_name, std::time_t from, std::time_t to,
+			std::time_t bucket, const std::vector<value_type>& layout);
+
+		virtual void put_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t time, const aggregate& data);
+		virtual rollup_data_t get_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t from, std::time_t to);
+
+		virtual void purge_data(const std::string& sensor_name, std::time_t resolution, std::time_t before);
 
 		virtual void prepare_entity(const std::string& sensor_name) = 0;
+		virtual void prepare_rollup_entity(const std::string& sensor_name, std::time_t resolution);
 
 	};
 }
@@ -0,0 +1,51 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_TIMESTAMP_H
+#define VIKKI_AGENT_TIMESTAMP_H
+
+#include <cstdint>
+#include <ctime>
+
+namespace vikki
+{
+	// microseconds since the Unix epoch
+	using timestamp = int64_t;
+
+	const timestamp timestamp_second = 1000000;
+
+	timestamp timestamp_now();
+
+	timestamp from_seconds(std::time_t time);
+	std::time_t to_seconds(timestamp time);
+
+	// wall-clock aligned multiples of an interval, the last one at or before the time and the first one after it
+	timestamp last_boundary(timestamp time, timestamp interval);
+	timestamp next_boundary(timestamp time, timestamp interval);
+}
+
+#endif // VIKKI_AGENT_TIMESTAMP_H
+
@@ -0,0 +1,204 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "aggregate.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace vikki
+{
+	namespace
+	{
+		template<typename T>
+		T load_value(const char *p)
+		{
+			T value;
+			std::memcpy(&value, p, sizeof(T));
+
+			return value;
+		}
+
+		template<typename T>
+		void store_value(char *p, T value)
+		{
+			std::memcpy(p, &value, sizeof(T));
+		}
+
+		template<typename T>
+		double merge_value(char *min, char *max, const char *value_min, const char *value_max, const char *value_avg, bool first)
+		{
+			const T vmin = load_value<T>(value_min);
+			const T vmax = load_value<T>(value_max);
+
+			if (first || vmin < load_value<T>(min))
+			{
+				store_value<T>(min, vmin);
+			}
+
+			if (first || vmax > load_value<T>(max))
+			{
+				store_value<T>(max, vmax);
+			}
+
+			return static_cast<double>(load_value<T>(value_avg));
+		}
+	}
+
+	std::time_t bucket_start(std::time_t time, std::time_t bucket)
+	{
+		if (bucket <= 1)
+		{
+			return time;
+		}
+
+		std::time_t offset = time % bucket;
+
+		if (offset < 0)
+		{
+			offset += bucket;
+		}
+
+		return time - offset;
+	}
+
+	aggregator::aggregator(const std::vector<value_type>& layout)
+		: _layout(layout), _size(layout_size(layout)), _count(0),
+		  _min(_size), _max(_size), _sum(layout.size())
+	{
+	}
+
+	aggregator::~aggregator()
+	{
+	}
+
+	void aggregator::add(const std::vector<char>& data)
+	{
+		if (data.size() < _size)
+		{
+			return;
+		}
+
+		add_values(data.data(), data.data(), data.data(), 1);
+	}
+
+	void aggregator::add(const aggregate& value)
+	{
+		if (value.count == 0 || value.min.size() < _size || value.max.size() < _size || value.avg.size() < _size)
+		{
+			return;
+		}
+
+		add_values(value.min.data(), value.max.data(), value.avg.data(), value.count);
+	}
+
+	bool aggregator::empty() const
+	{
+		return _count == 0;
+	}
+
+	aggregate aggregator::result() const
+	{
+		aggregate value;
+
+		value.count = _count;
+		value.min = _min;
+		value.max = _max;
+		value.avg = std::vector<char>(_size);
+
+		size_t offset = 0;
+
+		for (size_t i = 0; i < _layout.size(); ++i)
+		{
+			const double avg = _count > 0 ? _sum[i] / _count : 0.0;
+
+			switch (_layout[i])
+			{
+			case value_type::int64:
+				store_value<int64_t>(value.avg.data() + offset, std::llround(avg));
+				break;
+
+			case value_type::uint64:
+				store_value<uint64_t>(value.avg.data() + offset, static_cast<uint64_t>(avg + 0.5));
+				break;
+
+			case value_type::float64:
+				store_value<double>(value.avg.data() + offset, avg);
+				break;
+			}
+
+			offset += value_size(_layout[i]);
+		}
+
+		return value;
+	}
+
+	void aggregator::reset()
+	{
+		_count = 0;
+
+		std::fill(_min.begin(), _min.end(), 0);
+		std::fill(_max.begin(), _max.end(), 0);
+		std::fill(_sum.begin(), _sum.end(), 0.0);
+	}
+
+	void aggregator::add_values(const char *min, const char *max, const char *avg, uint64_t count)
+	{
+		const bool first = _count == 0;
+
+		size_t offset = 0;
+
+		for (size_t i = 0; i < _layout.size(); ++i)
+		{
+			char *field_min = _min.data() + offset;
+			char *field_max = _max.data() + offset;
+
+			double value = 0.0;
+
+			switch (_layout[i])
+			{
+			case value_type::int64:
+				value = merge_value<int64_t>(field_min, field_max, min + offset, max + offset, avg + offset, first);
+				break;
+
+			case value_type::uint64:
+				value = merge_value<uint64_t>(field_min, field_max, min + offset, max + offset, avg + offset, first);
+				break;
+
+			case value_type::float64:
+				value = merge_value<double>(field_min, field_max, min + offset, max + offset, avg + offset, first);
+				break;
+			}
+
+			_sum[i] += value * count;
+
+			offset += value_size(_layout[i]);
+		}
+
+		_count += count;
+	}
+}
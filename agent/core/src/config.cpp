@@ -27,6 +27,7 @@ SOFTWARE.
 #include "config.h"
 
 #include <fstream>
+#include <cmath>
 
 namespace vikki
 {
@@ -45,6 +46,7 @@ namespace vikki
 		load_storage_settings(data["storage"]);
 		load_sensors_settings(data["sensors"]);
 		load_network_settings(data["network"]);
+		load_rollup_settings(data["rollup"]);
 	}
 
 	config::~config()
@@ -66,6 +68,11 @@ namespace vikki
 		return _network;
 	}
 
+	config::rollup_info config::rollup() const
+	{
+		return _rollup;
+	}
+
 	void config::load_storage_settings(const nlohmann::json& node)
 	{
 		if (node.is_null())
@@ -99,6 +106,63 @@ namespace vikki
 
 			info.active = sensor["active"].get<bool>();
 			info.name = sensor["name"].get<std::string>();
+			info.instance = info.name;
+			info.interval = 3 * timestamp_second;
+			info.rates = false;
+			info.window = 0;
+			info.percentile = 0.0;
+
+			nlohmann::json instance_node = sensor["instance"];
+			if (!instance_node.is_null())
+			{
+				info.instance = instance_node.get<std::string>();
+			}
+
+			if (info.instance.empty() || info.instance.find_first_not_of("abcdefghijklmnopqrstuvwxyz0123456789_") != std::string::npos)
+			{
+				throw exception("Invalid sensor instance name \"" + info.instance + "\"");
+			}
+
+			nlohmann::json interval_node = sensor["interval"];
+			if (!interval_node.is_null())
+			{
+				const double interval = interval_node.get<double>();
+
+				if (interval < 0.001)
+				{
+					throw exception("Invalid sensor \"" + info.instance + "\" interval: " + std::to_string(interval));
+				}
+
+				info.interval = static_cast<timestamp>(std::llround(interval * timestamp_second));
+			}
+
+			nlohmann::json rates_node = sensor["rates"];
+			if (!rates_node.is_null())
+			{
+				info.rates = rates_node.get<bool>();
+			}
+
+			nlohmann::json window_node = sensor["window"];
+			if (!window_node.is_null())
+			{
+				info.window = window_node.get<std::time_t>();
+			}
+
+			if (info.window < 0)
+			{
+				throw exception("Invalid sensor \"" + info.instance + "\" window: " + std::to_string(info.window));
+			}
+
+			nlohmann::json percentile_node = sensor["percentile"];
+			if (!percentile_node.is_null())
+			{
+				info.percentile = percentile_node.get<double>();
+			}
+
+			if (info.percentile < 0.0 || info.percentile > 100.0)
+			{
+				throw exception("Invalid sensor \"" + info.instance + "\" percentile: " + std::to_string(info.percentile));
+			}
 
 			nlohmann::json params_node = sensor["params"];
 			if (!params_node.is_null())
@@ -111,6 +175,14 @@ namespace vikki
 				}
 			}
 
+			for (const sensor_info& other : _sensors)
+			{
+				if (other.active && info.active && other.instance == info.instance)
+				{
+					throw exception("Duplicate sensor instance \"" + info.instance + "\"");
+				}
+			}
+
 			_sensors.push_back(info);
 		}
 	}
@@ -145,4 +217,44 @@ namespace vikki
 			}
 		}
 	}
+
+	void config::load_rollup_settings(const nlohmann::json& node)
+	{
+		_rollup.enabled = false;
+		_rollup.raw_retention = 0;
+
+		if (node.is_null())
+		{
+			return;
+		}
+
+		_rollup.enabled = node["enable"].get<bool>();
+
+		nlohmann::json raw_retention_node = node["raw_retention"];
+		if (!raw_retention_node.is_null())
+		{
+			_rollup.raw_retention = raw_retention_node.get<std::time_t>();
+		}
+
+		for (const nlohmann::json& tier : node["tiers"])
+		{
+			rollup_tier_info info;
+
+			info.resolution = tier["resolution"].get<std::time_t>();
+			info.retention = 0;
+
+			nlohmann::json retention_node = tier["retention"];
+			if (!retention_node.is_null())
+			{
+				info.retention = retention_node.get<std::time_t>();
+			}
+
+			if (info.resolution <= 0)
+			{
+				throw exception("Invalid rollup tier resolution: " + std::to_string(info.resolution));
+			}
+
+			_rollup.tiers.push_back(info);
+		}
+	}
 }
@@ -0,0 +1,164 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "counter_rate.h"
+#include "exception.h"
+
+#include <cstring>
+#include <limits>
+
+namespace vikki
+{
+	namespace
+	{
+		template<typename T>
+		T load_value(const char *p)
+		{
+			T value;
+			std::memcpy(&value, p, sizeof(T));
+
+			return value;
+		}
+
+		// a decrease is a reset of the source, unless the counter is declared 32-bit and has wrapped
+		bool unsigned_delta(uint64_t previous, uint64_t current, bool wraps, double& delta)
+		{
+			if (current >= previous)
+			{
+				delta = static_cast<double>(current - previous);
+
+				return true;
+			}
+
+			if (wraps)
+			{
+				delta = static_cast<double>((current - previous) & std::numeric_limits<uint32_t>::max());
+
+				return true;
+			}
+
+			return false;
+		}
+
+		template<typename T>
+		bool signed_delta(T previous, T current, double& delta)
+		{
+			if (current >= previous)
+			{
+				delta = static_cast<double>(current) - static_cast<double>(previous);
+
+				return true;
+			}
+
+			return false;
+		}
+	}
+
+	counter_rate::counter_rate(const sensor_schema& schema)
+		: _schema(schema), _size(0), _ready(false)
+	{
+		for (sensor_field& field : _schema)
+		{
+			if (field.kind == field_kind::counter || field.kind == field_kind::counter32)
+			{
+				_counters.push_back(counter { _size, field.type, field.kind == field_kind::counter32, 0 });
+
+				field.type = value_type::float64;
+				field.kind = field_kind::gauge;
+			}
+
+			_size += value_size(field.type);
+		}
+	}
+
+	counter_rate::~counter_rate()
+	{
+	}
+
+	bool counter_rate::empty() const
+	{
+		return _counters.empty();
+	}
+
+	sensor_schema counter_rate::schema() const
+	{
+		return _schema;
+	}
+
+	bool counter_rate::apply(std::vector<char>& data)
+	{
+		if (data.size() != _size)
+		{
+			throw exception("Can't derive counter rates: payload size " + std::to_string(data.size()) +
+				" doesn't match schema size " + std::to_string(_size));
+		}
+
+		const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		const double elapsed = std::chrono::duration<double>(time - _time).count();
+		bool ready = _ready && elapsed > 0.0;
+
+		for (counter& item : _counters)
+		{
+			char *p = data.data() + item.offset;
+
+			uint64_t current;
+			std::memcpy(&current, p, sizeof(current));
+
+			double delta = 0.0;
+			bool counted = false;
+
+			switch (item.type)
+			{
+			case value_type::int64:
+				counted = signed_delta(load_value<int64_t>(reinterpret_cast<const char*>(&item.previous)),
+					load_value<int64_t>(p), delta);
+				break;
+
+			case value_type::uint64:
+				counted = unsigned_delta(item.previous, current, item.wraps, delta);
+				break;
+
+			case value_type::float64:
+				counted = signed_delta(load_value<double>(reinterpret_cast<const char*>(&item.previous)),
+					load_value<double>(p), delta);
+				break;
+			}
+
+			// after a reset the rate over the interval is unknown, so the sample is dropped like the first one
+			ready = ready && counted;
+
+			item.previous = current;
+
+			const double rate = ready ? delta / elapsed : 0.0;
+			std::memcpy(p, &rate, sizeof(rate));
+		}
+
+		_time = time;
+		_ready = true;
+
+		return ready;
+	}
+}
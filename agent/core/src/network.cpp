@@ -27,14 +27,14 @@ SOFTWARE.
 #include "network.h"
 #include "exception.h"
 #include "command.h"
-#include "sensor_loader.h"
 
 #include <iostream>
+#include <algorithm>
 
 namespace vikki
 {
-	network::network(storage *store)
-		: _storage(store)
+	network::network(storage *store, rollup *rollups)
+		: _storage(store), _rollup(rollups)
 	{
 	}
 
@@ -85,7 +85,12 @@ namespace vikki
 		_server.stop();
 	}
 
-	void network::sensor_updated(const std::string& name, std::time_t time, const std::vector<char>& data)
+	void network::sensor_added(const std::string& name, const std::string& plugin, const sensor_schema& schema)
+	{
+		_sensors.push_back(sensor_entry { name, plugin, schema });
+	}
+
+	void network::sensor_updated(const std::string& name, timestamp time, const std::vector<char>& data)
 	{
 		for (auto iter = _sensor_subscribers.cbegin(); iter != _sensor_subscribers.cend(); ++iter)
 		{
@@ -96,7 +101,7 @@ namespace vikki
 				std::unique_ptr<lnetlib::ostream> stream = subscriber.conn->create_stream(command::sensor_data_updated);
 
 				stream->write_string(name);
-				stream->write_int64(time);
+				stream->write_int64(is_precise(subscriber.conn) ? time : to_seconds(time));
 				stream->write_data_chunk(data);
 			}
 		}
@@ -135,6 +140,40 @@ namespace vikki
 	}
 
 	void network::sensor_get_data(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
+	{
+		std::unique_ptr<lnetlib::ostream> response = stream->create_response();
+
+		const bool precise = is_precise(conn);
+
+		const std::string& sensor_name = stream->read_string();
+		timestamp from = stream->read_int64();
+		timestamp to = stream->read_int64();
+
+		if (!precise)
+		{
+			from = from_seconds(from);
+			to = from_seconds(to + 1) - 1;
+		}
+
+		if (_storage != nullptr)
+		{
+			const storage::sensor_data_t& sensor_data = _storage->get_data(sensor_name, from, to);
+
+			response->write_uint64(sensor_data.size());
+
+			for (const std::pair<const timestamp, std::vector<char>>& iter : sensor_data)
+			{
+				response->write_int64(precise ? iter.first : to_seconds(iter.first));
+				response->write_data_chunk(iter.second);
+			}
+		}
+		else
+		{
+			response->write_uint64(0);
+		}
+	}
+
+	void network::sensor_get_aggregated_data(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
 	{
 		(void)conn;
 
@@ -143,39 +182,133 @@ namespace vikki
 		const std::string& sensor_name = stream->read_string();
 		const std::time_t from = stream->read_int64();
 		const std::time_t to = stream->read_int64();
+		std::time_t bucket = stream->read_int64();
+		const uint64_t max_points = stream->read_uint64();
+
+		if (bucket <= 0 && max_points > 0 && to > from)
+		{
+			bucket = (to - from + max_points - 1) / max_points;
+		}
+
+		if (bucket <= 0)
+		{
+			bucket = 1;
+		}
 
 		if (_storage != nullptr)
 		{
-			const storage::sensor_data_t& sensor_data = _storage->get_data(sensor_name, from, to);
+			const std::vector<value_type>& layout = schema_layout(find_schema(sensor_name));
+			const storage::aggregated_data_t& sensor_data = _rollup != nullptr ?
+				_rollup->get_aggregated_data(sensor_name, from, to, bucket, layout) :
+				_storage->get_aggregated_data(sensor_name, from, to, bucket, layout);
 
+			response->write_int64(bucket);
 			response->write_uint64(sensor_data.size());
 
-			for (const std::pair<std::time_t, std::vector<char>>& iter : sensor_data)
+			for (const std::pair<const std::time_t, aggregate>& iter : sensor_data)
 			{
 				response->write_int64(iter.first);
-				response->write_data_chunk(iter.second);
+				response->write_uint64(iter.second.count);
+				response->write_data_chunk(iter.second.min);
+				response->write_data_chunk(iter.second.max);
+				response->write_data_chunk(iter.second.avg);
 			}
 		}
 		else
 		{
+			response->write_int64(bucket);
 			response->write_uint64(0);
 		}
 	}
 
+	void network::sensor_get_schema(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
+	{
+		(void)conn;
+
+		std::unique_ptr<lnetlib::ostream> response = stream->create_response();
+
+		const std::string& sensor_name = stream->read_string();
+		const sensor_schema& schema = find_schema(sensor_name);
+
+		response->write_uint64(schema.size());
+
+		for (const sensor_field& field : schema)
+		{
+			response->write_string(field.name);
+			response->write_uint8(static_cast<uint8_t>(field.type));
+			response->write_uint8(static_cast<uint8_t>(field.kind));
+		}
+	}
+
 	void network::sensor_get_list(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
 	{
 		(void)conn;
 
 		std::unique_ptr<lnetlib::ostream> response = stream->create_response();
 
-		uint64_t count = sensor_loader::instance().get_sensor_count();
-		response->write_uint64(count);
+		response->write_uint64(_sensors.size());
+
+		for (const sensor_entry& entry : _sensors)
+		{
+			response->write_string(entry.name);
+		}
+	}
+
+	void network::sensor_get_list_ex(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
+	{
+		(void)conn;
+
+		std::unique_ptr<lnetlib::ostream> response = stream->create_response();
+
+		response->write_uint64(_sensors.size());
+
+		// the plugin name lets clients pick a dashboard for any instance of the plugin
+		for (const sensor_entry& entry : _sensors)
+		{
+			response->write_string(entry.name);
+			response->write_string(entry.plugin);
+		}
+	}
+
+	void network::set_time_resolution(std::shared_ptr<lnetlib::connection> conn, std::unique_ptr<lnetlib::istream> stream)
+	{
+		std::unique_ptr<lnetlib::ostream> response = stream->create_response();
+
+		const int64_t resolution = stream->read_int64();
+
+		auto iter = std::find(_precise_connections.begin(), _precise_connections.end(), conn);
+
+		if (resolution == timestamp_second)
+		{
+			if (iter == _precise_connections.end())
+			{
+				_precise_connections.push_back(conn);
+			}
+		}
+		else if (iter != _precise_connections.end())
+		{
+			_precise_connections.erase(iter);
+		}
+
+		response->write_int64(resolution == timestamp_second ? timestamp_second : 1);
+	}
 
-		for (uint64_t i = 0; i < count; ++i)
+	const sensor_schema& network::find_schema(const std::string& name) const
+	{
+		for (const sensor_entry& entry : _sensors)
 		{
-			std::string name = sensor_loader::instance().get_sensor_name(i);
-			response->write_string(name);
+			if (entry.name == name)
+			{
+				return entry.schema;
+			}
 		}
+
+		throw exception("Can't get sensor \"" + name + "\": sensor doesn't exist");
+	}
+
+	bool network::is_precise(std::shared_ptr<lnetlib::connection> conn) const
+	{
+		return std::find(_precise_connections.begin(), _precise_connections.end(), conn) != _precise_connections.end();
 	}
 
 	void network::connected(std::shared_ptr<lnetlib::connection> conn)
@@ -185,6 +318,9 @@ namespace vikki
 
 	void network::disconnected(std::shared_ptr<lnetlib::connection> conn)
 	{
+		_precise_connections.erase(std::remove(_precise_connections.begin(), _precise_connections.end(), conn),
+			_precise_connections.end());
+
 		for (auto iter = _sensor_subscribers.begin() ; iter != _sensor_subscribers.end(); )
 		{
 			const sensor_subscriber& subscriber = *iter;
@@ -216,6 +352,22 @@ namespace vikki
 			sensor_get_list(conn, std::move(stream));
 			break;
 
+		case command::get_sensor_aggregated_data:
+			sensor_get_aggregated_data(conn, std::move(stream));
+			break;
+
+		case command::get_sensor_schema:
+			sensor_get_schema(conn, std::move(stream));
+			break;
+
+		case command::set_time_resolution:
+			set_time_resolution(conn, std::move(stream));
+			break;
+
+		case command::get_sensor_list_ex:
+			sensor_get_list_ex(conn, std::move(stream));
+			break;
+
 		default:
 			break;
 
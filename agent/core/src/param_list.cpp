@@ -0,0 +1,102 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "param_list.h"
+
+#include <fnmatch.h>
+
+#include <sstream>
+
+namespace vikki
+{
+	std::vector<std::string> split_param_list(const std::string& value)
+	{
+		std::vector<std::string> result;
+
+		std::stringstream stream(value);
+		std::string item;
+
+		while (std::getline(stream, item, ','))
+		{
+			item.erase(0, item.find_first_not_of(" \t"));
+			item.erase(item.find_last_not_of(" \t") + 1);
+
+			if (!item.empty())
+			{
+				result.push_back(item);
+			}
+		}
+
+		return result;
+	}
+
+	name_filter::name_filter(const std::vector<std::string>& exclude)
+		: _exclude(exclude)
+	{
+	}
+
+	name_filter::~name_filter()
+	{
+	}
+
+	void name_filter::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("include");
+		if (iter != params.end())
+		{
+			_include = split_param_list(iter->second);
+		}
+
+		iter = params.find("exclude");
+		if (iter != params.end())
+		{
+			_exclude = split_param_list(iter->second);
+		}
+	}
+
+	bool name_filter::accepted(const char *name) const
+	{
+		if (!_include.empty() && !matches(_include, name))
+		{
+			return false;
+		}
+
+		return !matches(_exclude, name);
+	}
+
+	bool name_filter::matches(const std::vector<std::string>& patterns, const char *name)
+	{
+		for (const std::string& pattern : patterns)
+		{
+			if (fnmatch(pattern.c_str(), name, 0) == 0)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
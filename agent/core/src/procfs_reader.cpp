@@ -0,0 +1,120 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "procfs_reader.h"
+#include "exception.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+namespace vikki
+{
+	procfs_reader::procfs_reader(const std::string& path, size_t capacity)
+		: _path(path), _fd(-1), _buffer(capacity > 1 ? capacity : 2), _size(0)
+	{
+	}
+
+	procfs_reader::~procfs_reader()
+	{
+		close();
+	}
+
+	const std::string& procfs_reader::path() const
+	{
+		return _path;
+	}
+
+	const char* procfs_reader::read()
+	{
+		if (_fd < 0)
+		{
+			open();
+		}
+
+		_size = 0;
+
+		while (true)
+		{
+			const size_t request = _buffer.size() - _size - 1;
+
+			ssize_t len = pread(_fd, _buffer.data() + _size, request, _size);
+
+			if (len < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				int err = errno;
+
+				close();
+
+				throw exception("Can't read " + _path + ", error code: " + std::to_string(err));
+			}
+
+			_size += len;
+
+			// procfs returns a short read only at the end of the file
+			if (static_cast<size_t>(len) < request)
+			{
+				break;
+			}
+
+			_buffer.resize(_buffer.size() * 2);
+		}
+
+		_buffer[_size] = '\0';
+
+		return _buffer.data();
+	}
+
+	size_t procfs_reader::size() const
+	{
+		return _size;
+	}
+
+	void procfs_reader::close()
+	{
+		if (_fd >= 0)
+		{
+			::close(_fd);
+
+			_fd = -1;
+		}
+	}
+
+	void procfs_reader::open()
+	{
+		_fd = ::open(_path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (_fd < 0)
+		{
+			throw exception("Can't open " + _path + ", error code: " + std::to_string(errno));
+		}
+	}
+}
@@ -0,0 +1,148 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "procfs_table.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace vikki
+{
+	procfs_table::procfs_table(const std::vector<std::string>& keys, char separator)
+		: _keys(keys), _separator(separator)
+	{
+		for (size_t i = 0; i < _keys.size(); ++i)
+		{
+			_entries.push_back(entry { _keys[i], i });
+		}
+
+		std::sort(_entries.begin(), _entries.end(), [](const entry& left, const entry& right)
+		{
+			return left.key < right.key;
+		});
+	}
+
+	procfs_table::~procfs_table()
+	{
+	}
+
+	size_t procfs_table::size() const
+	{
+		return _keys.size();
+	}
+
+	const std::string& procfs_table::key(size_t index) const
+	{
+		return _keys.at(index);
+	}
+
+	size_t procfs_table::parse(const char *data, size_t size, uint64_t *values) const
+	{
+		std::fill(values, values + _keys.size(), 0);
+
+		size_t found = 0;
+
+		const char *p = data;
+		const char *end = data + size;
+
+		while (p < end && found < _entries.size())
+		{
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (eol == nullptr)
+			{
+				eol = end;
+			}
+
+			const char *sep = static_cast<const char*>(std::memchr(p, _separator, eol - p));
+			if (sep != nullptr)
+			{
+				const entry *item = find(p, sep - p);
+				if (item != nullptr)
+				{
+					values[item->index] = parse_value(sep + 1, eol);
+					++found;
+				}
+			}
+
+			p = eol + 1;
+		}
+
+		return found;
+	}
+
+	const procfs_table::entry* procfs_table::find(const char *key, size_t size) const
+	{
+		auto iter = std::lower_bound(_entries.begin(), _entries.end(), std::make_pair(key, size),
+			[](const entry& item, const std::pair<const char*, size_t>& value)
+		{
+			int cmp = item.key.compare(0, std::string::npos, value.first, value.second);
+
+			return cmp < 0;
+		});
+
+		if (iter == _entries.end() || iter->key.compare(0, std::string::npos, key, size) != 0)
+		{
+			return nullptr;
+		}
+
+		return &*iter;
+	}
+
+	uint64_t procfs_table::parse_value(const char *p, const char *end) const
+	{
+		while (p < end && (*p == ' ' || *p == '\t'))
+		{
+			++p;
+		}
+
+		uint64_t value = 0;
+
+		while (p < end && *p >= '0' && *p <= '9')
+		{
+			value = value * 10 + (*p - '0');
+			++p;
+		}
+
+		while (p < end && (*p == ' ' || *p == '\t'))
+		{
+			++p;
+		}
+
+		if (p < end)
+		{
+			if (*p == 'k')
+			{
+				value *= 1024;
+			}
+			else if (*p == 'M')
+			{
+				value *= 1024 * 1024;
+			}
+		}
+
+		return value;
+	}
+}
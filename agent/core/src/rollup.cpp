@@ -0,0 +1,235 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "rollup.h"
+
+#include <algorithm>
+
+namespace vikki
+{
+	rollup::rollup(storage *store, const config::rollup_info& info)
+		: _storage(store), _enabled(info.enabled), _raw_retention(info.raw_retention),
+		  _tiers(info.tiers.begin(), info.tiers.end())
+	{
+		std::sort(_tiers.begin(), _tiers.end(), [](const config::rollup_tier_info& a, const config::rollup_tier_info& b)
+		{
+			return a.resolution < b.resolution;
+		});
+	}
+
+	rollup::~rollup()
+	{
+	}
+
+	void rollup::prepare_entity(const std::string& sensor_name, const std::vector<value_type>& layout)
+	{
+		if (!_enabled || layout.empty())
+		{
+			return;
+		}
+
+		for (const config::rollup_tier_info& tier : _tiers)
+		{
+			_storage->prepare_rollup_entity(sensor_name, tier.resolution);
+		}
+	}
+
+	void rollup::prepare_window(const std::string& sensor_name, std::time_t resolution)
+	{
+		for (const config::rollup_tier_info& tier : _tiers)
+		{
+			if (_enabled && tier.resolution == resolution)
+			{
+				throw exception("Can't prepare window for sensor " + sensor_name + ": window " + std::to_string(resolution) +
+					" conflicts with rollup tier resolution");
+			}
+		}
+
+		_storage->prepare_rollup_entity(sensor_name, resolution);
+
+		_windows[sensor_name] = resolution;
+	}
+
+	void rollup::put_data(const std::string& sensor_name, const std::vector<value_type>& layout, std::time_t time, const std::vector<char>& data)
+	{
+		if (!_enabled || layout.empty())
+		{
+			return;
+		}
+
+		auto iter = _states.find(sensor_name);
+		if (iter == _states.end())
+		{
+			std::vector<tier_state> states;
+
+			for (const config::rollup_tier_info& tier : _tiers)
+			{
+				states.push_back(tier_state { tier.resolution, bucket_start(time, tier.resolution), aggregator(layout) });
+			}
+
+			iter = _states.insert(std::make_pair(sensor_name, states)).first;
+		}
+
+		for (tier_state& state : iter->second)
+		{
+			const std::time_t bucket_time = bucket_start(time, state.resolution);
+
+			if (bucket_time != state.bucket_time)
+			{
+				flush_tier(sensor_name, state);
+
+				state.bucket_time = bucket_time;
+			}
+
+			state.data.add(data);
+		}
+	}
+
+	storage::aggregated_data_t rollup::get_aggregated_data(const std::string& sensor_name, std::time_t from, std::time_t to,
+		std::time_t& bucket, const std::vector<value_type>& layout)
+	{
+		std::time_t resolution = 0;
+
+		if (_enabled && !layout.empty())
+		{
+			for (const config::rollup_tier_info& info : _tiers)
+			{
+				if (info.resolution <= bucket)
+				{
+					resolution = info.resolution;
+				}
+			}
+		}
+
+		auto window = _windows.find(sensor_name);
+		if (window != _windows.end() && !layout.empty() && window->second <= bucket && window->second > resolution)
+		{
+			resolution = window->second;
+		}
+
+		if (resolution == 0)
+		{
+			return _storage->get_aggregated_data(sensor_name, from, to, bucket, layout);
+		}
+
+		bucket = (bucket + resolution - 1) / resolution * resolution;
+
+		storage::rollup_data_t rows = _storage->get_rollup_data(sensor_name, resolution,
+			bucket_start(from, resolution), to);
+
+		// the bucket still being built in memory has not been flushed yet, without it every range ending now misses its tail
+		auto states = _states.find(sensor_name);
+		if (states != _states.end())
+		{
+			for (const tier_state& state : states->second)
+			{
+				if (state.resolution == resolution && !state.data.empty() &&
+					state.bucket_time >= bucket_start(from, resolution) && state.bucket_time <= to)
+				{
+					rows.insert(std::make_pair(state.bucket_time, state.data.result()));
+				}
+			}
+		}
+
+		storage::aggregated_data_t result;
+
+		aggregator bucket_aggregator(layout);
+		std::time_t bucket_time = 0;
+
+		for (const std::pair<const std::time_t, aggregate>& iter : rows)
+		{
+			const std::time_t time = bucket_start(iter.first, bucket);
+
+			if (time != bucket_time && !bucket_aggregator.empty())
+			{
+				result[bucket_time] = bucket_aggregator.result();
+				bucket_aggregator.reset();
+			}
+
+			bucket_time = time;
+			bucket_aggregator.add(iter.second);
+		}
+
+		if (!bucket_aggregator.empty())
+		{
+			result[bucket_time] = bucket_aggregator.result();
+		}
+
+		return result;
+	}
+
+	void rollup::flush()
+	{
+		for (std::pair<const std::string, std::vector<tier_state>>& iter : _states)
+		{
+			for (tier_state& state : iter.second)
+			{
+				flush_tier(iter.first, state);
+			}
+		}
+	}
+
+	void rollup::purge(const std::string& sensor_name, const std::vector<value_type>& layout, std::time_t time)
+	{
+		// raw and window tables are purged whether the tiers are enabled or not
+		if (_raw_retention > 0)
+		{
+			_storage->purge_data(sensor_name, 0, time - _raw_retention);
+
+			auto window = _windows.find(sensor_name);
+			if (window != _windows.end())
+			{
+				_storage->purge_data(sensor_name, window->second, time - _raw_retention);
+			}
+		}
+
+		if (!_enabled || layout.empty())
+		{
+			return;
+		}
+
+		for (const config::rollup_tier_info& tier : _tiers)
+		{
+			if (tier.retention > 0)
+			{
+				_storage->purge_data(sensor_name, tier.resolution, time - tier.retention);
+			}
+		}
+	}
+
+	void rollup::flush_tier(const std::string& sensor_name, tier_state& state)
+	{
+		if (state.data.empty())
+		{
+			return;
+		}
+
+		const aggregate& data = state.data.result();
+		state.data.reset();
+
+		_storage->put_rollup_data(sensor_name, state.resolution, state.bucket_time, data);
+	}
+}
@@ -0,0 +1,166 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "sample_window.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace vikki
+{
+	namespace
+	{
+		template<typename T>
+		void select_value(const std::vector<char>& samples, size_t size, size_t offset, double percentile, char *result)
+		{
+			const size_t count = samples.size() / size;
+
+			std::vector<T> values(count);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				std::memcpy(&values[i], samples.data() + i * size + offset, sizeof(T));
+			}
+
+			// nearest-rank percentile over every sample of the window
+			size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * count));
+			rank = rank > 0 ? rank - 1 : 0;
+
+			std::nth_element(values.begin(), values.begin() + rank, values.end());
+
+			std::memcpy(result, &values[rank], sizeof(T));
+		}
+	}
+
+	sample_window::sample_window(const std::vector<value_type>& layout, std::time_t length, double percentile)
+		: _layout(layout), _size(layout_size(layout)), _length(length), _percentile(percentile),
+		  _start(0), _last_time(0), _data(layout)
+	{
+	}
+
+	sample_window::~sample_window()
+	{
+	}
+
+	std::time_t sample_window::length() const
+	{
+		return _length;
+	}
+
+	std::time_t sample_window::start() const
+	{
+		return _start;
+	}
+
+	bool sample_window::empty() const
+	{
+		return _data.empty();
+	}
+
+	bool sample_window::expired(timestamp time) const
+	{
+		return !empty() && bucket_start(to_seconds(time), _length) != _start;
+	}
+
+	void sample_window::add(timestamp time, const std::vector<char>& data)
+	{
+		if (data.size() < _size)
+		{
+			return;
+		}
+
+		if (empty())
+		{
+			_start = bucket_start(to_seconds(time), _length);
+		}
+
+		_data.add(data);
+
+		_last_time = time;
+		_last.assign(data.begin(), data.begin() + _size);
+
+		if (_percentile > 0.0)
+		{
+			_samples.insert(_samples.end(), data.begin(), data.begin() + _size);
+		}
+	}
+
+	aggregate sample_window::result() const
+	{
+		return _data.result();
+	}
+
+	timestamp sample_window::last_time() const
+	{
+		return _last_time;
+	}
+
+	const std::vector<char>& sample_window::last() const
+	{
+		return _last;
+	}
+
+	std::vector<char> sample_window::percentile() const
+	{
+		std::vector<char> result(_size);
+
+		if (_samples.empty())
+		{
+			return result;
+		}
+
+		size_t offset = 0;
+
+		for (value_type type : _layout)
+		{
+			switch (type)
+			{
+			case value_type::int64:
+				select_value<int64_t>(_samples, _size, offset, _percentile, result.data() + offset);
+				break;
+
+			case value_type::uint64:
+				select_value<uint64_t>(_samples, _size, offset, _percentile, result.data() + offset);
+				break;
+
+			case value_type::float64:
+				select_value<double>(_samples, _size, offset, _percentile, result.data() + offset);
+				break;
+			}
+
+			offset += value_size(type);
+		}
+
+		return result;
+	}
+
+	void sample_window::reset()
+	{
+		_data.reset();
+		_samples.clear();
+	}
+}
@@ -0,0 +1,119 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "schema.h"
+#include "exception.h"
+
+namespace vikki
+{
+	size_t value_size(value_type type)
+	{
+		switch (type)
+		{
+		case value_type::int64:
+			return sizeof(int64_t);
+
+		case value_type::uint64:
+			return sizeof(uint64_t);
+
+		case value_type::float64:
+			return sizeof(double);
+		}
+
+		return 0;
+	}
+
+	size_t layout_size(const std::vector<value_type>& layout)
+	{
+		size_t size = 0;
+
+		for (value_type type : layout)
+		{
+			size += value_size(type);
+		}
+
+		return size;
+	}
+
+	std::vector<value_type> schema_layout(const sensor_schema& schema)
+	{
+		std::vector<value_type> layout;
+		layout.reserve(schema.size());
+
+		for (const sensor_field& field : schema)
+		{
+			layout.push_back(field.type);
+		}
+
+		return layout;
+	}
+
+	sensor_field parse_sensor_field(const std::string& spec, value_type default_type)
+	{
+		// "name" keeps the default type, "name:double", "name:int64", "name:uint64", "name:counter" and
+		// "name:counter32" (a counter that wraps at 2^32) override it
+		sensor_field field { spec, default_type, field_kind::gauge };
+
+		const size_t colon = spec.rfind(':');
+		if (colon == std::string::npos)
+		{
+			return field;
+		}
+
+		const std::string type = spec.substr(colon + 1);
+
+		field.name = spec.substr(0, colon);
+
+		if (type == "double")
+		{
+			field.type = value_type::float64;
+		}
+		else if (type == "int64")
+		{
+			field.type = value_type::int64;
+		}
+		else if (type == "uint64")
+		{
+			field.type = value_type::uint64;
+		}
+		else if (type == "counter")
+		{
+			field.type = value_type::uint64;
+			field.kind = field_kind::counter;
+		}
+		else if (type == "counter32")
+		{
+			field.type = value_type::uint64;
+			field.kind = field_kind::counter32;
+		}
+		else
+		{
+			throw exception("Can't parse field \"" + spec + "\": type \"" + type + "\" doesn't exist");
+		}
+
+		return field;
+	}
+}
@@ -26,6 +26,8 @@ SOFTWARE.
 
 #include "sensor.h"
 
+#include <cstring>
+
 namespace vikki
 {
 	sensor::sensor()
@@ -36,6 +38,48 @@ namespace vikki
 	{
 	}
 
+	std::vector<char> sensor::data()
+	{
+		std::vector<char> result;
+		size_t size = 0;
+
+		while ((size = sample(result.data(), result.size())) > result.size())
+		{
+			result.resize(size);
+		}
+
+		result.resize(size);
+
+		return result;
+	}
+
+	size_t sensor::sample(char *buffer, size_t capacity)
+	{
+		const std::vector<char>& result = data();
+
+		if (result.size() <= capacity)
+		{
+			std::memcpy(buffer, result.data(), result.size());
+		}
+
+		return result.size();
+	}
+
+	sensor_schema sensor::schema() const
+	{
+		return sensor_schema();
+	}
+
+	bool sensor::fixed_layout() const
+	{
+		return false;
+	}
+
+	std::vector<value_type> sensor::layout() const
+	{
+		return schema_layout(schema());
+	}
+
 	void sensor::init(const std::map<std::string, std::string>& params)
 	{
 	}
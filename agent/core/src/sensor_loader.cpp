@@ -53,28 +53,28 @@ namespace vikki
 
 	size_t sensor_loader::get_sensor_count() const
 	{
-		return _plugins.size();
+		return _instances.size();
 	}
 
 	std::string sensor_loader::get_sensor_name(size_t idx) const
 	{
-		if (idx >= _plugins.size())
+		if (idx >= _instances.size())
 		{
 			throw exception("Can't get sensor name: out of index");
 		}
 
-		return _plugins.at(idx).sensor_handle->name();
+		return _instances.at(idx).name;
 	}
 
 	sensor* sensor_loader::get_sensor(const std::string& name) const
 	{
 		sensor *sensor_handle = nullptr;
 
-		for (const sensor_plugin& plugin : _plugins)
+		for (const sensor_instance& instance : _instances)
 		{
-			if (plugin.sensor_handle->name() == name)
+			if (instance.name == name)
 			{
-				sensor_handle = plugin.sensor_handle;
+				sensor_handle = instance.sensor_handle;
 
 				break;
 			}
@@ -88,6 +88,33 @@ namespace vikki
 		return sensor_handle;
 	}
 
+	sensor* sensor_loader::create_sensor(const std::string& name, const std::string& instance_name)
+	{
+		for (const sensor_instance& instance : _instances)
+		{
+			if (instance.name == instance_name)
+			{
+				throw exception("Can't create sensor \"" + instance_name + "\": instance already exists");
+			}
+		}
+
+		for (const sensor_plugin& plugin : _plugins)
+		{
+			if (plugin.name != name)
+			{
+				continue;
+			}
+
+			sensor_instance instance { instance_name, plugin.create_sensor(), plugin.destroy_sensor };
+
+			_instances.push_back(instance);
+
+			return instance.sensor_handle;
+		}
+
+		throw exception("Can't create sensor \"" + instance_name + "\": sensor plugin \"" + name + "\" doesn't exist");
+	}
+
 	void sensor_loader::load_sensors()
 	{
 		DIR *dir = opendir(_path.c_str());
@@ -138,7 +165,24 @@ namespace vikki
 				throw exception("Lookup \"destroy_sensor\" function in sensor plugin \"" + filename + "\" failed: " + std::string(dlerror()));
 			}
 
-			plugin.sensor_handle = plugin.create_sensor();
+			// a probe instance only tells the plugin name, sensors are created per configured instance,
+			// so a plugin that can't even be probed is skipped instead of stopping the whole agent
+			try
+			{
+				sensor *probe = plugin.create_sensor();
+
+				plugin.name = probe->name();
+				plugin.destroy_sensor(probe);
+			}
+			catch (const std::exception& ex)
+			{
+				dlclose(plugin.plugin_handle);
+
+				std::cerr << "Sensor plugin \"" << filename << "\" skipped: " << ex.what() << "\n";
+				std::cerr.flush();
+
+				continue;
+			}
 
 			_plugins.push_back(plugin);
 		}
@@ -148,10 +192,15 @@ namespace vikki
 
 	void sensor_loader::unload_sensors()
 	{
-		for (const sensor_plugin& plugin : _plugins)
+		for (const sensor_instance& instance : _instances)
 		{
-			plugin.destroy_sensor(plugin.sensor_handle);
+			instance.destroy_sensor(instance.sensor_handle);
+		}
+
+		_instances.clear();
 
+		for (const sensor_plugin& plugin : _plugins)
+		{
 			dlclose(plugin.plugin_handle);
 		}
 
@@ -30,11 +30,13 @@ SOFTWARE.
 
 #include <iostream>
 #include <functional>
+#include <algorithm>
+#include <cstdio>
 
 namespace vikki
 {
 	service::service()
-		: _config("vikki-agent.cfg")
+		: _config("vikki-agent.cfg"), _active_storage(nullptr), _purge_time(0)
 	{
 		storage_loader::instance();
 		sensor_loader::instance();
@@ -54,9 +56,27 @@ namespace vikki
 		signal_set.async_wait(std::bind(&asio::io_service::stop, &_service));
 
 		asio::steady_timer timer(_service);
-		timer_tick(timer);
+		schedule(timer);
 
 		_service.run();
+
+		for (active_sensor& sens : _sensors)
+		{
+			try
+			{
+				flush_window(sens);
+			}
+			catch (const std::exception& ex)
+			{
+				std::cerr << "Error occurred while flushing sensor windows: " << ex.what() << "\n";
+				std::cerr.flush();
+			}
+		}
+
+		if (_rollup != nullptr)
+		{
+			_rollup->flush();
+		}
 	}
 
 	void service::init_storage()
@@ -73,6 +93,8 @@ namespace vikki
 		_active_storage = storage_loader::instance().get_storage(info.name);
 
 		_active_storage->open(info.params);
+
+		_rollup.reset(new rollup(_active_storage, _config.rollup()));
 	}
 
 	void service::init_sensors()
@@ -84,14 +106,67 @@ namespace vikki
 				continue;
 			}
 
-			sensor *sens = sensor_loader::instance().get_sensor(sensor_info.name);
+			sensor *sens = sensor_loader::instance().create_sensor(sensor_info.name, sensor_info.instance);
 
 			sens->init(sensor_info.params);
 
+			active_sensor active { sensor_info.instance, sens, sensor_info.interval, next_boundary(timestamp_now(), sensor_info.interval),
+				sens->schema(), std::vector<value_type>(),
+				std::vector<char>(), nullptr, nullptr, std::string() };
+
+			if (sensor_info.rates)
+			{
+				active.rates.reset(new counter_rate(active.schema));
+
+				if (active.rates->empty())
+				{
+					active.rates.reset();
+				}
+				else if (sens->fixed_layout())
+				{
+					throw exception("Can't derive rates of sensor \"" + active.name + "\": plugin \"" + sensor_info.name +
+						"\" has a fixed payload layout");
+				}
+				else
+				{
+					active.schema = active.rates->schema();
+				}
+			}
+
+			active.layout = schema_layout(active.schema);
+
 			if (_active_storage != nullptr)
 			{
-				_active_storage->prepare_entity(sensor_info.name);
+				_active_storage->prepare_entity(active.name);
+
+				_rollup->prepare_entity(active.name, active.layout);
+
+				if (sensor_info.window > 0)
+				{
+					if (active.layout.empty())
+					{
+						throw exception("Can't aggregate sensor \"" + active.name + "\" into windows: sensor has no schema");
+					}
+
+					active.window.reset(new sample_window(active.layout, sensor_info.window, sensor_info.percentile));
+
+					_rollup->prepare_window(active.name, sensor_info.window);
+				}
+
+				if (active.window != nullptr && sensor_info.percentile > 0.0)
+				{
+					char suffix[32];
+					std::snprintf(suffix, sizeof(suffix), "%g", sensor_info.percentile);
+
+					active.percentile_name = active.name + "_p" + suffix;
+					active.percentile_name.erase(std::remove(active.percentile_name.begin(), active.percentile_name.end(), '.'),
+						active.percentile_name.end());
+
+					_active_storage->prepare_entity(active.percentile_name);
+				}
 			}
+
+			_sensors.push_back(std::move(active));
 		}
 	}
 
@@ -106,7 +181,12 @@ namespace vikki
 			return;
 		}
 
-		_network.reset(new network(_active_storage));
+		_network.reset(new network(_active_storage, _rollup.get()));
+
+		for (const active_sensor& sens : _sensors)
+		{
+			_network->sensor_added(sens.name, sens.handle->name(), sens.schema);
+		}
 
 		if (info.security.enable)
 		{
@@ -126,42 +206,85 @@ namespace vikki
 	void service::timer_tick(asio::steady_timer& timer)
 	{
 		update_sensors();
+		purge_storage();
 
-		timer.expires_from_now(std::chrono::seconds(3));
+		schedule(timer);
+	}
+
+	void service::schedule(asio::steady_timer& timer)
+	{
+		const timestamp now = timestamp_now();
+
+		timestamp deadline = now + timestamp_second;
+
+		for (const active_sensor& sens : _sensors)
+		{
+			deadline = std::min(deadline, sens.deadline);
+		}
+
+		// deadlines are wall clock boundaries, re-derived on every tick so the steady timer never accumulates drift
+		timer.expires_from_now(std::chrono::microseconds(std::max<timestamp>(deadline - now, 0)));
 		timer.async_wait(std::bind(&service::timer_tick, this, std::ref(timer)));
 	}
 
 	void service::update_sensors()
 	{
-		std::time_t time = std::time(nullptr);
+		const timestamp now = timestamp_now();
 
-		for (const config::sensor_info& sensor_info : _config.sensors())
+		for (active_sensor& sens : _sensors)
 		{
-			if (!sensor_info.active)
+			if (sens.deadline - now > sens.interval)
+			{
+				// wall clock stepped back, realign instead of waiting for the old boundary
+				sens.deadline = next_boundary(now, sens.interval);
+			}
+
+			if (sens.deadline > now)
 			{
 				continue;
 			}
 
+			// a late tick samples the latest boundary that has passed, boundaries missed before it are skipped
+			const timestamp time = last_boundary(now, sens.interval);
+
+			sens.deadline = time + sens.interval;
+
 			try
 			{
-				sensor *sens = sensor_loader::instance().get_sensor(sensor_info.name);
+				sample_sensor(sens);
 
-				const std::string& sensor_name = sens->name();
-				const std::vector<char>& sensor_data = sens->data();
+				if (sens.buffer.size() == 0)
+				{
+					continue;
+				}
 
-				if (sensor_data.size() == 0)
+				if (sens.rates != nullptr && !sens.rates->apply(sens.buffer))
 				{
 					continue;
 				}
 
 				if (_active_storage != nullptr)
 				{
-					_active_storage->put_data(sensor_name, time, sensor_data);
+					if (sens.window != nullptr)
+					{
+						if (sens.window->expired(time))
+						{
+							flush_window(sens);
+						}
+
+						sens.window->add(time, sens.buffer);
+					}
+					else
+					{
+						_active_storage->put_data(sens.name, time, sens.buffer);
+					}
+
+					_rollup->put_data(sens.name, sens.layout, to_seconds(time), sens.buffer);
 				}
 
 				if (_network != nullptr)
 				{
-					_network->sensor_updated(sensor_name, time, sensor_data);
+					_network->sensor_updated(sens.name, time, sens.buffer);
 				}
 			}
 			catch (const std::exception& ex)
@@ -171,4 +294,81 @@ namespace vikki
 			}
 		}
 	}
+
+	void service::sample_sensor(active_sensor& sens)
+	{
+		sens.buffer.resize(sens.buffer.capacity());
+
+		size_t size = sens.handle->sample(sens.buffer.data(), sens.buffer.size());
+
+		if (size > sens.buffer.size())
+		{
+			sens.buffer.resize(size);
+
+			size = sens.handle->sample(sens.buffer.data(), sens.buffer.size());
+
+			if (size > sens.buffer.size())
+			{
+				sens.buffer.clear();
+
+				throw exception("Can't sample sensor \"" + sens.name + "\": payload size is unstable");
+			}
+		}
+
+		sens.buffer.resize(size);
+	}
+
+	void service::flush_window(active_sensor& sens)
+	{
+		if (sens.window == nullptr || sens.window->empty())
+		{
+			return;
+		}
+
+		const std::time_t start = sens.window->start();
+		const timestamp last_time = sens.window->last_time();
+		const std::vector<char> last = sens.window->last();
+		const aggregate& summary = sens.window->result();
+		const std::vector<char>& percentile = sens.percentile_name.empty() ? std::vector<char>() : sens.window->percentile();
+
+		sens.window->reset();
+
+		_active_storage->put_data(sens.name, last_time, last);
+		_active_storage->put_rollup_data(sens.name, sens.window->length(), start, summary);
+
+		if (!sens.percentile_name.empty())
+		{
+			_active_storage->put_data(sens.percentile_name, from_seconds(start), percentile);
+		}
+	}
+
+	void service::purge_storage()
+	{
+		std::time_t time = std::time(nullptr);
+
+		if (_active_storage == nullptr || time - _purge_time < 60 * 60)
+		{
+			return;
+		}
+
+		_purge_time = time;
+
+		for (const active_sensor& sens : _sensors)
+		{
+			try
+			{
+				_rollup->purge(sens.name, sens.layout, time);
+
+				if (!sens.percentile_name.empty())
+				{
+					_rollup->purge(sens.percentile_name, std::vector<value_type>(), time);
+				}
+			}
+			catch (const std::exception& ex)
+			{
+				std::cerr << "Error occurred while purging storage: " << ex.what() << "\n";
+				std::cerr.flush();
+			}
+		}
+	}
 }
@@ -25,6 +25,7 @@ SOFTWARE.
 */
 
 #include "storage.h"
+#include "exception.h"
 
 namespace vikki
 {
@@ -35,4 +36,69 @@ namespace vikki
 	storage::~storage()
 	{
 	}
+
+	storage::aggregated_data_t storage::get_aggregated_data(const std::string& sensor_name, std::time_t from, std::time_t to,
+		std::time_t bucket, const std::vector<value_type>& layout)
+	{
+		aggregated_data_t result;
+
+		if (layout.empty())
+		{
+			return result;
+		}
+
+		const sensor_data_t& data = get_data(sensor_name, from_seconds(from), from_seconds(to + 1) - 1);
+
+		aggregator bucket_aggregator(layout);
+		std::time_t bucket_time = 0;
+
+		for (const std::pair<const timestamp, std::vector<char>>& iter : data)
+		{
+			const std::time_t time = bucket_start(to_seconds(iter.first), bucket);
+
+			if (time != bucket_time && !bucket_aggregator.empty())
+			{
+				result[bucket_time] = bucket_aggregator.result();
+				bucket_aggregator.reset();
+			}
+
+			bucket_time = time;
+			bucket_aggregator.add(iter.second);
+		}
+
+		if (!bucket_aggregator.empty())
+		{
+			result[bucket_time] = bucket_aggregator.result();
+		}
+
+		return result;
+	}
+
+	void storage::put_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t time, const aggregate& data)
+	{
+		(void)time;
+		(void)data;
+
+		throw exception("Can't put rollup data of sensor " + sensor_name + " (" + std::to_string(resolution) + "): storage \"" + name() + "\" doesn't support rollups");
+	}
+
+	storage::rollup_data_t storage::get_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t from, std::time_t to)
+	{
+		(void)from;
+		(void)to;
+
+		throw exception("Can't get rollup data of sensor " + sensor_name + " (" + std::to_string(resolution) + "): storage \"" + name() + "\" doesn't support rollups");
+	}
+
+	void storage::purge_data(const std::string& sensor_name, std::time_t resolution, std::time_t before)
+	{
+		(void)sensor_name;
+		(void)resolution;
+		(void)before;
+	}
+
+	void storage::prepare_rollup_entity(const std::string& sensor_name, std::time_t resolution)
+	{
+		throw exception("Can't prepare rollup entity for sensor " + sensor_name + " (" + std::to_string(resolution) + "): storage \"" + name() + "\" doesn't support rollups");
+	}
 }
@@ -0,0 +1,81 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "timestamp.h"
+#include "exception.h"
+
+#include <cerrno>
+#include <string>
+#include <time.h>
+
+namespace vikki
+{
+	timestamp timestamp_now()
+	{
+		timespec value;
+
+		if (clock_gettime(CLOCK_REALTIME, &value) != 0)
+		{
+			throw exception("Can't get current time, error code: " + std::to_string(errno));
+		}
+
+		return static_cast<timestamp>(value.tv_sec) * timestamp_second + value.tv_nsec / 1000;
+	}
+
+	timestamp from_seconds(std::time_t time)
+	{
+		return static_cast<timestamp>(time) * timestamp_second;
+	}
+
+	std::time_t to_seconds(timestamp time)
+	{
+		timestamp seconds = time / timestamp_second;
+
+		if (time % timestamp_second < 0)
+		{
+			--seconds;
+		}
+
+		return static_cast<std::time_t>(seconds);
+	}
+
+	timestamp last_boundary(timestamp time, timestamp interval)
+	{
+		timestamp offset = time % interval;
+
+		if (offset < 0)
+		{
+			offset += interval;
+		}
+
+		return time - offset;
+	}
+
+	timestamp next_boundary(timestamp time, timestamp interval)
+	{
+		return last_boundary(time, interval) + interval;
+	}
+}
@@ -0,0 +1,133 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_CGROUP_SENSOR_H
+#define VIKKI_CGROUP_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "procfs_table.h"
+
+#include <sys/types.h>
+
+#include <chrono>
+
+namespace vikki
+{
+	class cgroup_sensor
+		: public sensor
+	{
+	public:
+		cgroup_sensor();
+		~cgroup_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum counter_index
+		{
+			usage_usec,
+			user_usec,
+			system_usec,
+			throttled_usec,
+			read_bytes,
+			write_bytes,
+			reads,
+			writes,
+			counter_count
+		};
+
+		enum memory_index
+		{
+			anon,
+			file,
+			memory_count
+		};
+
+		struct cgroup
+		{
+			int fd;
+			ino_t inode;
+			int watch;
+			uint64_t generation;
+			bool measured;
+			uint64_t counters[counter_count];
+			std::chrono::steady_clock::time_point time;
+		};
+
+		struct cgroup_usage
+		{
+			const std::string *path;
+			double cpu;
+			double cpu_user;
+			double cpu_system;
+			double cpu_throttled;
+			uint64_t memory_current;
+			uint64_t memory_anon;
+			uint64_t memory_file;
+			double io_read_bytes;
+			double io_write_bytes;
+			double io_reads;
+			double io_writes;
+		};
+
+		std::string _root;
+		size_t _depth;
+		int _inotify;
+		bool _walk_needed;
+		uint64_t _generation;
+
+		std::map<std::string, cgroup> _groups;
+		std::vector<cgroup_usage> _usages;
+		bool _usages_ready;
+
+		procfs_table _cpu_stat;
+		procfs_table _memory_stat;
+		std::vector<char> _buffer;
+
+		void update_usages();
+		bool tree_changed();
+		void walk();
+		void walk_directory(const std::string& path, size_t depth);
+		void close_group(cgroup& group);
+		bool read_group(const cgroup& group, const char *filename, size_t& size);
+
+		static void parse_io_stat(const char *data, uint64_t *counters);
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_CGROUP_SENSOR_H
+
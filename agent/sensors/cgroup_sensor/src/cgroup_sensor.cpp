@@ -0,0 +1,470 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "cgroup_sensor.h"
+#include "cgroup_payload.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace vikki
+{
+	cgroup_sensor::cgroup_sensor()
+		: _root("/sys/fs/cgroup"), _depth(2), _inotify(-1), _walk_needed(true),
+		  _generation(0), _usages_ready(false), _cpu_stat({ "usage_usec", "user_usec", "system_usec", "throttled_usec" }, ' '),
+		  _memory_stat({ "anon", "file" }, ' '), _buffer(4096)
+	{
+	}
+
+	cgroup_sensor::~cgroup_sensor()
+	{
+		for (std::pair<const std::string, cgroup>& item : _groups)
+		{
+			close_group(item.second);
+		}
+
+		if (_inotify != -1)
+		{
+			close(_inotify);
+		}
+	}
+
+	std::string cgroup_sensor::name() const
+	{
+		return "cgroup";
+	}
+
+	size_t cgroup_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (!_usages_ready)
+		{
+			update_usages();
+
+			_usages_ready = true;
+		}
+
+		if (_usages.empty())
+		{
+			_usages_ready = false;
+
+			return 0;
+		}
+
+		size_t size = cgroup_payload::header_size();
+
+		for (const cgroup_usage& usage : _usages)
+		{
+			size += cgroup_payload::entry_size(usage.path->size());
+		}
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		payload::writer out(buffer);
+
+		cgroup_payload::write_header(out, static_cast<uint32_t>(_usages.size()));
+
+		for (const cgroup_usage& usage : _usages)
+		{
+			char *entry = cgroup_payload::write_entry(out, *usage.path);
+
+			cgroup_payload::encode(entry, usage.cpu, usage.cpu_user, usage.cpu_system, usage.cpu_throttled,
+				usage.memory_current, usage.memory_anon, usage.memory_file,
+				usage.io_read_bytes, usage.io_write_bytes, usage.io_reads, usage.io_writes);
+		}
+
+		_usages_ready = false;
+
+		return out.size();
+	}
+
+	void cgroup_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("root");
+		if (iter != params.end())
+		{
+			_root = iter->second;
+
+			while (_root.size() > 1 && _root.back() == '/')
+			{
+				_root.pop_back();
+			}
+		}
+
+		iter = params.find("depth");
+		if (iter != params.end())
+		{
+			_depth = std::stoul(iter->second);
+		}
+
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotify == -1)
+		{
+			throw exception("Can't initialize inotify, error code: " + std::to_string(errno));
+		}
+	}
+
+	void cgroup_sensor::update_usages()
+	{
+		if (tree_changed() || _walk_needed)
+		{
+			walk();
+		}
+
+		const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+		_usages.clear();
+
+		for (std::pair<const std::string, cgroup>& item : _groups)
+		{
+			cgroup& group = item.second;
+
+			uint64_t counters[counter_count] = { 0 };
+			uint64_t memory[memory_count] = { 0 };
+			uint64_t memory_current = 0;
+			size_t size = 0;
+
+			// a group removed since the last walk fails here and goes away with the next inotify event
+			if (!read_group(group, "cpu.stat", size))
+			{
+				continue;
+			}
+
+			_cpu_stat.parse(_buffer.data(), size, counters);
+
+			if (read_group(group, "memory.current", size))
+			{
+				memory_current = std::strtoull(_buffer.data(), nullptr, 10);
+			}
+
+			if (read_group(group, "memory.stat", size))
+			{
+				_memory_stat.parse(_buffer.data(), size, memory);
+			}
+
+			if (read_group(group, "io.stat", size))
+			{
+				parse_io_stat(_buffer.data(), counters);
+			}
+
+			const double elapsed = std::chrono::duration<double>(time - group.time).count();
+
+			if (group.measured && elapsed > 0.0)
+			{
+				double rates[counter_count];
+
+				for (size_t i = 0; i < counter_count; ++i)
+				{
+					rates[i] = counters[i] >= group.counters[i] ? (counters[i] - group.counters[i]) / elapsed : 0.0;
+				}
+
+				cgroup_usage usage;
+
+				// cpu times are in microseconds, so a rate of 1e6 is one fully used cpu
+				usage.path = &item.first;
+				usage.cpu = rates[usage_usec] / 1e4;
+				usage.cpu_user = rates[user_usec] / 1e4;
+				usage.cpu_system = rates[system_usec] / 1e4;
+				usage.cpu_throttled = rates[throttled_usec] / 1e4;
+				usage.memory_current = memory_current;
+				usage.memory_anon = memory[anon];
+				usage.memory_file = memory[file];
+				usage.io_read_bytes = rates[read_bytes];
+				usage.io_write_bytes = rates[write_bytes];
+				usage.io_reads = rates[reads];
+				usage.io_writes = rates[writes];
+
+				_usages.push_back(usage);
+			}
+
+			std::memcpy(group.counters, counters, sizeof(counters));
+			group.time = time;
+			group.measured = true;
+		}
+	}
+
+	bool cgroup_sensor::tree_changed()
+	{
+		char events[4096];
+		bool changed = false;
+
+		while (true)
+		{
+			ssize_t len = read(_inotify, events, sizeof(events));
+
+			if (len < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				break;
+			}
+
+			if (len == 0)
+			{
+				break;
+			}
+
+			// any directory event (or a queue overflow) means the tree has to be walked again
+			changed = true;
+		}
+
+		return changed;
+	}
+
+	void cgroup_sensor::walk()
+	{
+		_walk_needed = false;
+		++_generation;
+
+		walk_directory("/", 0);
+
+		for (auto iter = _groups.begin(); iter != _groups.end(); )
+		{
+			if (iter->second.generation != _generation)
+			{
+				close_group(iter->second);
+
+				iter = _groups.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+
+	void cgroup_sensor::walk_directory(const std::string& path, size_t depth)
+	{
+		const std::string full_path = path == "/" ? _root : _root + path;
+
+		struct stat info;
+
+		if (stat(full_path.c_str(), &info) == -1)
+		{
+			return;
+		}
+
+		// a group deleted and created again under the same path needs a fresh descriptor and watch
+		auto iter = _groups.find(path);
+		if (iter != _groups.end() && iter->second.inode != info.st_ino)
+		{
+			close_group(iter->second);
+
+			_groups.erase(iter);
+			iter = _groups.end();
+		}
+
+		if (iter == _groups.end())
+		{
+			int fd = open(full_path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (fd == -1)
+			{
+				return;
+			}
+
+			if (fstat(fd, &info) == -1)
+			{
+				close(fd);
+
+				return;
+			}
+
+			cgroup group;
+
+			group.fd = fd;
+			group.inode = info.st_ino;
+			group.watch = -1;
+			group.measured = false;
+
+			iter = _groups.insert(std::make_pair(path, group)).first;
+		}
+
+		cgroup& group = iter->second;
+		group.generation = _generation;
+
+		if (depth >= _depth)
+		{
+			return;
+		}
+
+		if (group.watch == -1)
+		{
+			group.watch = inotify_add_watch(_inotify, full_path.c_str(),
+				IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+		}
+
+		// a fresh descriptor, since a directory stream would move the offset of the shared one
+		int fd = openat(group.fd, ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			return;
+		}
+
+		DIR *dir = fdopendir(fd);
+		if (dir == nullptr)
+		{
+			close(fd);
+
+			return;
+		}
+
+		std::vector<std::string> children;
+
+		while (dirent *entry = readdir(dir))
+		{
+			if (entry->d_type == DT_DIR && std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0)
+			{
+				children.push_back(entry->d_name);
+			}
+		}
+
+		closedir(dir);
+
+		for (const std::string& child : children)
+		{
+			walk_directory(path == "/" ? "/" + child : path + "/" + child, depth + 1);
+		}
+	}
+
+	void cgroup_sensor::close_group(cgroup& group)
+	{
+		if (group.watch != -1)
+		{
+			inotify_rm_watch(_inotify, group.watch);
+		}
+
+		close(group.fd);
+	}
+
+	bool cgroup_sensor::read_group(const cgroup& group, const char *filename, size_t& size)
+	{
+		int fd = openat(group.fd, filename, O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			return false;
+		}
+
+		size = 0;
+
+		while (true)
+		{
+			ssize_t len = read(fd, _buffer.data() + size, _buffer.size() - size - 1);
+
+			if (len < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				close(fd);
+
+				return false;
+			}
+
+			if (len == 0)
+			{
+				break;
+			}
+
+			size += len;
+
+			if (size + 1 == _buffer.size())
+			{
+				_buffer.resize(_buffer.size() * 2);
+			}
+		}
+
+		close(fd);
+
+		_buffer[size] = '\0';
+
+		return true;
+	}
+
+	void cgroup_sensor::parse_io_stat(const char *data, uint64_t *counters)
+	{
+		// one line per device: "8:0 rbytes=1 wbytes=2 rios=3 wios=4 dbytes=0 dios=0"
+		static const struct
+		{
+			const char *key;
+			size_t size;
+			counter_index index;
+		} keys[] = {
+			{ "rbytes=", 7, read_bytes },
+			{ "wbytes=", 7, write_bytes },
+			{ "rios=", 5, reads },
+			{ "wios=", 5, writes }
+		};
+
+		const char *p = data;
+
+		while (*p != '\0')
+		{
+			while (*p == ' ' || *p == '\n')
+			{
+				++p;
+			}
+
+			for (const auto& key : keys)
+			{
+				if (std::strncmp(p, key.key, key.size) == 0)
+				{
+					counters[key.index] += std::strtoull(p + key.size, nullptr, 10);
+
+					break;
+				}
+			}
+
+			while (*p != '\0' && *p != ' ' && *p != '\n')
+			{
+				++p;
+			}
+		}
+	}
+
+	sensor *create_sensor()
+	{
+		return new cgroup_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
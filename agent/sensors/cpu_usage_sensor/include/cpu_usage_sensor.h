@@ -0,0 +1,89 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_CPU_USAGE_SENSOR_H
+#define VIKKI_CPU_USAGE_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "procfs_reader.h"
+
+namespace vikki
+{
+	class cpu_usage_sensor
+		: public sensor
+	{
+	public:
+		cpu_usage_sensor();
+		~cpu_usage_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+		bool fixed_layout() const override;
+
+	private:
+		enum counter_index
+		{
+			counter_user,
+			counter_nice,
+			counter_system,
+			counter_idle,
+			counter_iowait,
+			counter_irq,
+			counter_softirq,
+			counter_steal,
+			counter_count
+		};
+
+		struct cpu_counters
+		{
+			uint64_t values[counter_count];
+			bool valid;
+		};
+
+		procfs_reader _stat;
+		size_t _cpu_count;
+		std::vector<cpu_counters> _previous;
+		std::vector<cpu_counters> _current;
+		bool _has_previous;
+
+		size_t payload_size() const;
+
+		void parse_stat(std::vector<cpu_counters>& counters);
+		const char* parse_counters(const char *p, const char *end, cpu_counters& counters) const;
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_CPU_USAGE_SENSOR_H
+
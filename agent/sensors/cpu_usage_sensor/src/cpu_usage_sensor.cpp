@@ -0,0 +1,216 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "cpu_usage_sensor.h"
+#include "cpu_usage_payload.h"
+
+#include <unistd.h>
+
+#include <cstring>
+
+namespace vikki
+{
+	cpu_usage_sensor::cpu_usage_sensor()
+		: _stat("/proc/stat", 16384), _cpu_count(1), _has_previous(false)
+	{
+		long count = sysconf(_SC_NPROCESSORS_CONF);
+
+		if (count > 0)
+		{
+			_cpu_count = static_cast<size_t>(count);
+		}
+
+		_previous.resize(_cpu_count + 1);
+		_current.resize(_cpu_count + 1);
+	}
+
+	cpu_usage_sensor::~cpu_usage_sensor()
+	{
+	}
+
+	std::string cpu_usage_sensor::name() const
+	{
+		return "cpu_usage";
+	}
+
+	size_t cpu_usage_sensor::sample(char *buffer, size_t capacity)
+	{
+		const size_t size = payload_size();
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		parse_stat(_current);
+
+		if (!_has_previous)
+		{
+			_previous.swap(_current);
+			_has_previous = true;
+
+			return 0;
+		}
+
+		for (size_t i = 0; i < _current.size(); ++i)
+		{
+			const cpu_counters& previous = _previous[i];
+			const cpu_counters& current = _current[i];
+
+			uint64_t delta[counter_count] = { 0 };
+			uint64_t total = 0;
+
+			if (previous.valid && current.valid)
+			{
+				for (size_t j = 0; j < counter_count; ++j)
+				{
+					delta[j] = current.values[j] > previous.values[j] ? current.values[j] - previous.values[j] : 0;
+					total += delta[j];
+				}
+			}
+
+			const double scale = total > 0 ? 100.0 / total : 0.0;
+
+			cpu_usage_payload::encode(buffer + i * cpu_usage_payload::size(),
+				(delta[counter_user] + delta[counter_nice]) * scale,
+				delta[counter_system] * scale,
+				delta[counter_iowait] * scale,
+				(delta[counter_irq] + delta[counter_softirq]) * scale,
+				delta[counter_steal] * scale);
+		}
+
+		_previous.swap(_current);
+
+		return size;
+	}
+
+	sensor_schema cpu_usage_sensor::schema() const
+	{
+		sensor_schema result;
+
+		for (size_t i = 0; i <= _cpu_count; ++i)
+		{
+			const std::string prefix = i == 0 ? "total" : "cpu" + std::to_string(i - 1);
+
+			for (size_t j = 0; j < cpu_usage_payload::count(); ++j)
+			{
+				result.push_back(sensor_field { prefix + "_" + cpu_usage_payload::name(j), value_type::float64,
+					field_kind::gauge });
+			}
+		}
+
+		return result;
+	}
+
+	bool cpu_usage_sensor::fixed_layout() const
+	{
+		return true;
+	}
+
+	size_t cpu_usage_sensor::payload_size() const
+	{
+		return (_cpu_count + 1) * cpu_usage_payload::size();
+	}
+
+	void cpu_usage_sensor::parse_stat(std::vector<cpu_counters>& counters)
+	{
+		for (cpu_counters& item : counters)
+		{
+			item.valid = false;
+		}
+
+		const char *p = _stat.read();
+		const char *end = p + _stat.size();
+
+		while (end - p > 3 && std::memcmp(p, "cpu", 3) == 0)
+		{
+			p += 3;
+
+			size_t index = 0;
+
+			if (*p >= '0' && *p <= '9')
+			{
+				size_t cpu = 0;
+
+				while (p < end && *p >= '0' && *p <= '9')
+				{
+					cpu = cpu * 10 + (*p - '0');
+					++p;
+				}
+
+				index = cpu + 1;
+			}
+
+			if (index < counters.size())
+			{
+				p = parse_counters(p, end, counters[index]);
+			}
+
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (eol == nullptr)
+			{
+				break;
+			}
+
+			p = eol + 1;
+		}
+	}
+
+	const char* cpu_usage_sensor::parse_counters(const char *p, const char *end, cpu_counters& counters) const
+	{
+		for (size_t i = 0; i < counter_count; ++i)
+		{
+			while (p < end && *p == ' ')
+			{
+				++p;
+			}
+
+			uint64_t value = 0;
+
+			while (p < end && *p >= '0' && *p <= '9')
+			{
+				value = value * 10 + (*p - '0');
+				++p;
+			}
+
+			counters.values[i] = value;
+		}
+
+		counters.valid = true;
+
+		return p;
+	}
+
+	sensor *create_sensor()
+	{
+		return new cpu_usage_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
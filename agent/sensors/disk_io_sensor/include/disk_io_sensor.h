@@ -0,0 +1,110 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_DISK_IO_SENSOR_H
+#define VIKKI_DISK_IO_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "param_list.h"
+#include "procfs_reader.h"
+
+#include <chrono>
+#include <unordered_map>
+
+namespace vikki
+{
+	class disk_io_sensor
+		: public sensor
+	{
+	public:
+		disk_io_sensor();
+		~disk_io_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum
+		{
+			counter_count = 7,
+			stat_count = 7,
+			name_capacity = 32
+		};
+
+		enum counter_index
+		{
+			reads,
+			read_sectors,
+			read_time,
+			writes,
+			write_sectors,
+			write_time,
+			io_time
+		};
+
+		struct device_counters
+		{
+			uint64_t values[counter_count];
+			uint64_t generation;
+			bool accepted;
+		};
+
+		struct device_stats
+		{
+			char name[name_capacity];
+			uint8_t name_size;
+			double values[stat_count];
+		};
+
+		procfs_reader _diskstats;
+		name_filter _filter;
+		bool _partitions;
+
+		std::unordered_map<std::string, device_counters> _counters;
+		std::vector<device_stats> _stats;
+		std::string _key;
+		uint64_t _generation;
+		std::chrono::steady_clock::time_point _time;
+		bool _stats_ready;
+
+		void parse_diskstats();
+
+		static bool is_partition(const char *device);
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_DISK_IO_SENSOR_H
+
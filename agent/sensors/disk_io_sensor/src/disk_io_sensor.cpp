@@ -0,0 +1,288 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "disk_io_sensor.h"
+#include "disk_io_payload.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace vikki
+{
+	disk_io_sensor::disk_io_sensor()
+		: _diskstats("/proc/diskstats", 16384), _filter({ "loop*", "ram*", "zram*" }), _partitions(false),
+		  _generation(0), _time(std::chrono::steady_clock::now()), _stats_ready(false)
+	{
+		_key.reserve(name_capacity);
+	}
+
+	disk_io_sensor::~disk_io_sensor()
+	{
+	}
+
+	std::string disk_io_sensor::name() const
+	{
+		return "disk_io";
+	}
+
+	size_t disk_io_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (!_stats_ready)
+		{
+			parse_diskstats();
+
+			_stats_ready = true;
+		}
+
+		if (_stats.empty())
+		{
+			_stats_ready = false;
+
+			return 0;
+		}
+
+		size_t size = disk_io_payload::header_size();
+
+		for (const device_stats& stats : _stats)
+		{
+			size += disk_io_payload::entry_size(stats.name_size);
+		}
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		payload::writer out(buffer);
+
+		disk_io_payload::write_header(out, static_cast<uint32_t>(_stats.size()));
+
+		for (const device_stats& stats : _stats)
+		{
+			char *entry = disk_io_payload::write_entry(out, stats.name, stats.name_size);
+
+			disk_io_payload::encode(entry, stats.values[0], stats.values[1], stats.values[2], stats.values[3],
+				stats.values[4], stats.values[5], stats.values[6]);
+		}
+
+		_stats_ready = false;
+
+		return out.size();
+	}
+
+	void disk_io_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		_filter.init(params);
+
+		auto iter = params.find("partitions");
+		if (iter != params.end())
+		{
+			_partitions = iter->second == "true";
+		}
+	}
+
+	void disk_io_sensor::parse_diskstats()
+	{
+		static const uint64_t sector_size = 512;
+
+		const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		const double elapsed = std::chrono::duration<double>(time - _time).count();
+
+		_time = time;
+		++_generation;
+
+		_stats.clear();
+
+		const char *p = _diskstats.read();
+		const char *end = p + _diskstats.size();
+
+		while (p < end)
+		{
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (eol == nullptr)
+			{
+				eol = end;
+			}
+
+			// major and minor numbers precede the device name
+			for (int i = 0; i < 2; ++i)
+			{
+				while (p < eol && *p == ' ')
+				{
+					++p;
+				}
+
+				while (p < eol && *p != ' ')
+				{
+					++p;
+				}
+			}
+
+			while (p < eol && *p == ' ')
+			{
+				++p;
+			}
+
+			const char *name = p;
+
+			while (p < eol && *p != ' ')
+			{
+				++p;
+			}
+
+			const size_t name_size = p - name;
+
+			if (name_size == 0 || name_size >= name_capacity)
+			{
+				p = eol + 1;
+
+				continue;
+			}
+
+			char device[name_capacity];
+
+			std::memcpy(device, name, name_size);
+			device[name_size] = '\0';
+
+			_key.assign(device, name_size);
+
+			auto iter = _counters.find(_key);
+			if (iter == _counters.end())
+			{
+				device_counters counters;
+
+				std::memset(counters.values, 0, sizeof(counters.values));
+				counters.generation = 0;
+				counters.accepted = _filter.accepted(device) && (_partitions || !is_partition(device));
+
+				iter = _counters.insert(std::make_pair(_key, counters)).first;
+			}
+
+			device_counters& counters = iter->second;
+			const bool known = counters.generation != 0;
+
+			counters.generation = _generation;
+
+			if (!counters.accepted)
+			{
+				p = eol + 1;
+
+				continue;
+			}
+
+			uint64_t columns[10] = { 0 };
+
+			for (size_t i = 0; i < 10; ++i)
+			{
+				while (p < eol && *p == ' ')
+				{
+					++p;
+				}
+
+				while (p < eol && *p >= '0' && *p <= '9')
+				{
+					columns[i] = columns[i] * 10 + (*p - '0');
+					++p;
+				}
+			}
+
+			const uint64_t values[counter_count] = { columns[0], columns[2], columns[3],
+				columns[4], columns[6], columns[7], columns[9] };
+
+			if (known && elapsed > 0.0)
+			{
+				uint64_t delta[counter_count];
+
+				for (size_t i = 0; i < counter_count; ++i)
+				{
+					delta[i] = values[i] >= counters.values[i] ? values[i] - counters.values[i] : 0;
+				}
+
+				device_stats stats;
+
+				std::memcpy(stats.name, device, name_size);
+				stats.name_size = static_cast<uint8_t>(name_size);
+
+				stats.values[disk_io_payload::reads] = delta[reads] / elapsed;
+				stats.values[disk_io_payload::writes] = delta[writes] / elapsed;
+				stats.values[disk_io_payload::read_bytes] = delta[read_sectors] * sector_size / elapsed;
+				stats.values[disk_io_payload::write_bytes] = delta[write_sectors] * sector_size / elapsed;
+				stats.values[disk_io_payload::read_latency] = delta[reads] > 0
+					? static_cast<double>(delta[read_time]) / delta[reads] : 0.0;
+				stats.values[disk_io_payload::write_latency] = delta[writes] > 0
+					? static_cast<double>(delta[write_time]) / delta[writes] : 0.0;
+				stats.values[disk_io_payload::utilization] = std::min(delta[io_time] / (elapsed * 10.0), 100.0);
+
+				_stats.push_back(stats);
+			}
+
+			std::memcpy(counters.values, values, sizeof(values));
+
+			p = eol + 1;
+		}
+
+		for (auto iter = _counters.begin(); iter != _counters.end(); )
+		{
+			if (iter->second.generation != _generation)
+			{
+				iter = _counters.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+
+	bool disk_io_sensor::is_partition(const char *device)
+	{
+		// whole disks are listed in /sys/block, with '/' in names spelled as '!'
+		std::string path = "/sys/block/";
+		path += device;
+
+		for (size_t i = 11; i < path.size(); ++i)
+		{
+			if (path[i] == '/')
+			{
+				path[i] = '!';
+			}
+		}
+
+		return access(path.c_str(), F_OK) != 0;
+	}
+
+	sensor *create_sensor()
+	{
+		return new disk_io_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
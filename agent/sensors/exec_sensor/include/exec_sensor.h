@@ -0,0 +1,99 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_EXEC_SENSOR_H
+#define VIKKI_EXEC_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "param_list.h"
+
+#include <sys/types.h>
+
+#include <chrono>
+
+namespace vikki
+{
+	class exec_sensor
+		: public sensor
+	{
+	public:
+		exec_sensor();
+		~exec_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum class protocol
+		{
+			line,
+			length
+		};
+
+		struct field_info
+		{
+			std::string name;
+			value_type type;
+			field_kind kind;
+			size_t offset;
+		};
+
+		std::string _command;
+		protocol _protocol;
+		std::vector<field_info> _fields;
+		size_t _size;
+		std::chrono::milliseconds _timeout;
+
+		pid_t _pid;
+		int _socket;
+		std::chrono::steady_clock::time_point _restart_time;
+		std::chrono::seconds _backoff;
+		std::vector<char> _input;
+
+		void start();
+		void stop();
+		void fail(const std::string& reason);
+
+		void request(char *buffer);
+		void receive(std::chrono::steady_clock::time_point deadline);
+		void parse_line(char *line, char *buffer) const;
+		void write_value(const field_info& field, const char *text, char *buffer) const;
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_EXEC_SENSOR_H
+
@@ -0,0 +1,419 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "exec_sensor.h"
+
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+extern char **environ;
+
+namespace vikki
+{
+	exec_sensor::exec_sensor()
+		: _protocol(protocol::line), _size(0), _timeout(1000), _pid(-1), _socket(-1),
+		  _restart_time(std::chrono::steady_clock::now()), _backoff(1)
+	{
+	}
+
+	exec_sensor::~exec_sensor()
+	{
+		stop();
+	}
+
+	std::string exec_sensor::name() const
+	{
+		return "exec";
+	}
+
+	size_t exec_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (_command.empty() || _size == 0)
+		{
+			return 0;
+		}
+
+		if (capacity < _size)
+		{
+			return _size;
+		}
+
+		try
+		{
+			if (_pid == -1)
+			{
+				if (std::chrono::steady_clock::now() < _restart_time)
+				{
+					return 0;
+				}
+
+				start();
+			}
+
+			request(buffer);
+		}
+		catch (const std::exception& ex)
+		{
+			fail(ex.what());
+
+			return 0;
+		}
+
+		_backoff = std::chrono::seconds(1);
+
+		return _size;
+	}
+
+	sensor_schema exec_sensor::schema() const
+	{
+		sensor_schema result;
+
+		for (const field_info& field : _fields)
+		{
+			result.push_back(sensor_field { field.name, field.type, field.kind });
+		}
+
+		return result;
+	}
+
+	void exec_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("command");
+		if (iter != params.end())
+		{
+			_command = iter->second;
+		}
+
+		iter = params.find("protocol");
+		if (iter != params.end())
+		{
+			if (iter->second == "line")
+			{
+				_protocol = protocol::line;
+			}
+			else if (iter->second == "length")
+			{
+				_protocol = protocol::length;
+			}
+			else
+			{
+				throw exception("Can't use exec sensor protocol \"" + iter->second + "\": protocol doesn't exist");
+			}
+		}
+
+		iter = params.find("timeout");
+		if (iter != params.end())
+		{
+			_timeout = std::chrono::milliseconds(std::stoul(iter->second));
+		}
+
+		iter = params.find("fields");
+		if (iter != params.end())
+		{
+			for (const std::string& spec : split_param_list(iter->second))
+			{
+				const sensor_field parsed = parse_sensor_field(spec, value_type::float64);
+				field_info field { parsed.name, parsed.type, parsed.kind, _size };
+
+				_size += value_size(field.type);
+
+				_fields.push_back(field);
+			}
+		}
+	}
+
+	void exec_sensor::start()
+	{
+		int fds[2];
+
+		// a socket pair rather than pipes, so a dead command can't raise SIGPIPE in the agent
+		if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) == -1)
+		{
+			throw exception("Can't create socket pair, error code: " + std::to_string(errno));
+		}
+
+		posix_spawn_file_actions_t actions;
+		posix_spawn_file_actions_init(&actions);
+		posix_spawn_file_actions_adddup2(&actions, fds[1], STDIN_FILENO);
+		posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+
+		// own process group, so a pipeline started by the shell is killed as a whole
+		posix_spawnattr_t attributes;
+		posix_spawnattr_init(&attributes);
+		posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP);
+		posix_spawnattr_setpgroup(&attributes, 0);
+
+		char *argv[] = { const_cast<char*>("/bin/sh"), const_cast<char*>("-c"), const_cast<char*>(_command.c_str()), nullptr };
+
+		int error = posix_spawn(&_pid, "/bin/sh", &actions, &attributes, argv, environ);
+
+		posix_spawnattr_destroy(&attributes);
+		posix_spawn_file_actions_destroy(&actions);
+
+		close(fds[1]);
+
+		if (error != 0)
+		{
+			close(fds[0]);
+
+			_pid = -1;
+
+			throw exception("Can't start \"" + _command + "\", error code: " + std::to_string(error));
+		}
+
+		_socket = fds[0];
+	}
+
+	void exec_sensor::stop()
+	{
+		if (_socket != -1)
+		{
+			close(_socket);
+
+			_socket = -1;
+		}
+
+		if (_pid != -1)
+		{
+			kill(-_pid, SIGKILL);
+			waitpid(_pid, nullptr, 0);
+
+			_pid = -1;
+		}
+	}
+
+	void exec_sensor::fail(const std::string& reason)
+	{
+		stop();
+
+		std::cerr << "Error occurred while sampling \"" << _command << "\": " << reason
+			<< ", restarting in " << _backoff.count() << " s\n";
+		std::cerr.flush();
+
+		_restart_time = std::chrono::steady_clock::now() + _backoff;
+		_backoff = std::min(_backoff * 2, std::chrono::seconds(60));
+	}
+
+	void exec_sensor::request(char *buffer)
+	{
+		_input.clear();
+
+		if (send(_socket, "\n", 1, MSG_NOSIGNAL) != 1)
+		{
+			throw exception("Can't send request, error code: " + std::to_string(errno));
+		}
+
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + _timeout;
+
+		if (_protocol == protocol::line)
+		{
+			char *eol = nullptr;
+
+			while ((eol = static_cast<char*>(std::memchr(_input.data(), '\n', _input.size()))) == nullptr)
+			{
+				receive(deadline);
+			}
+
+			*eol = '\0';
+
+			parse_line(_input.data(), buffer);
+
+			return;
+		}
+
+		while (_input.size() < sizeof(uint32_t))
+		{
+			receive(deadline);
+		}
+
+		uint32_t size = 0;
+		std::memcpy(&size, _input.data(), sizeof(size));
+
+		if (size != _size)
+		{
+			throw exception("Can't read reply of " + std::to_string(size) + " bytes, expected " + std::to_string(_size));
+		}
+
+		while (_input.size() < sizeof(uint32_t) + size)
+		{
+			receive(deadline);
+		}
+
+		std::memcpy(buffer, _input.data() + sizeof(uint32_t), size);
+	}
+
+	void exec_sensor::receive(std::chrono::steady_clock::time_point deadline)
+	{
+		const long long remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+			deadline - std::chrono::steady_clock::now()).count();
+
+		pollfd descriptor { _socket, POLLIN, 0 };
+
+		int result = remaining > 0 ? poll(&descriptor, 1, static_cast<int>(remaining)) : 0;
+
+		if (result < 0)
+		{
+			if (errno == EINTR)
+			{
+				return;
+			}
+
+			throw exception("Can't wait for reply, error code: " + std::to_string(errno));
+		}
+
+		if (result == 0)
+		{
+			throw exception("Reply timed out after " + std::to_string(_timeout.count()) + " ms");
+		}
+
+		char chunk[4096];
+
+		ssize_t len = recv(_socket, chunk, sizeof(chunk), 0);
+
+		if (len < 0)
+		{
+			if (errno == EINTR)
+			{
+				return;
+			}
+
+			throw exception("Can't read reply, error code: " + std::to_string(errno));
+		}
+
+		if (len == 0)
+		{
+			throw exception("Command exited");
+		}
+
+		_input.insert(_input.end(), chunk, chunk + len);
+	}
+
+	void exec_sensor::parse_line(char *line, char *buffer) const
+	{
+		// "1.5 2 3" fills fields in order, "name=1.5" fills the named one, missing fields stay zero
+		std::memset(buffer, 0, _size);
+
+		size_t position = 0;
+		char *token = line;
+
+		while (*token != '\0')
+		{
+			while (*token == ' ' || *token == '\t' || *token == '\r')
+			{
+				++token;
+			}
+
+			if (*token == '\0')
+			{
+				break;
+			}
+
+			char *end = token;
+
+			while (*end != '\0' && *end != ' ' && *end != '\t' && *end != '\r')
+			{
+				++end;
+			}
+
+			const char *separator = static_cast<const char*>(std::memchr(token, '=', end - token));
+
+			if (separator == nullptr)
+			{
+				if (position < _fields.size())
+				{
+					write_value(_fields[position], token, buffer);
+				}
+
+				++position;
+			}
+			else
+			{
+				const size_t name_size = separator - token;
+
+				for (const field_info& field : _fields)
+				{
+					if (field.name.size() == name_size && field.name.compare(0, name_size, token, name_size) == 0)
+					{
+						write_value(field, separator + 1, buffer);
+
+						break;
+					}
+				}
+			}
+
+			token = end;
+		}
+	}
+
+	void exec_sensor::write_value(const field_info& field, const char *text, char *buffer) const
+	{
+		char *p = buffer + field.offset;
+
+		switch (field.type)
+		{
+		case value_type::int64:
+		{
+			int64_t value = std::strtoll(text, nullptr, 10);
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+
+		case value_type::uint64:
+		{
+			uint64_t value = std::strtoull(text, nullptr, 10);
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+
+		case value_type::float64:
+		{
+			double value = std::strtod(text, nullptr);
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+		}
+	}
+
+	sensor *create_sensor()
+	{
+		return new exec_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
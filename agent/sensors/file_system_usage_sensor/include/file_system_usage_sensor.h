@@ -29,6 +29,11 @@ SOFTWARE.
 
 #include "exception.h"
 #include "sensor.h"
+#include "file_system_usage_payload.h"
+#include "mount_probe.h"
+
+#include <chrono>
+#include <memory>
 
 namespace vikki
 {
@@ -40,30 +45,36 @@ namespace vikki
 		~file_system_usage_sensor() override;
 
 		std::string name() const override;
-		std::vector<char> data() override;
+		size_t sample(char *buffer, size_t capacity) override;
+
+		void init(const std::map<std::string, std::string>& params) override;
 
 	private:
-		struct file_system
-		{
-			std::string dir;
-			std::string device;
-			std::string type;
-			std::string options;
-		};
-
-		struct file_system_info
-		{
-			uint64_t total;
-			uint64_t free;
-			uint64_t avail;
-			uint64_t files;
-			uint64_t free_files;
-		};
-
-		uint64_t blocks_to_bytes(uint64_t value, uint64_t bsize) const;
+		typedef file_system_usage_payload::mount file_system;
+
+		int _mounts_fd;
+		bool _mounts_valid;
+		std::vector<file_system> _systems;
+
+		uint32_t _generation;
+		bool _mounts_sent;
+		size_t _keyframe_interval;
+		size_t _keyframe_samples;
+
+		std::chrono::milliseconds _timeout;
+		std::vector<std::unique_ptr<mount_probe>> _probes;
+		std::vector<file_system_usage_payload::usage> _usages;
+		uint32_t _usages_generation;
+		bool _usages_ready;
+
+		bool mounts_changed();
+		const std::vector<file_system>& file_system_list();
 
 		std::vector<file_system> get_file_system_list() const;
-		file_system_info get_file_system_info(const std::string& dir) const;
+		bool same_file_systems(const std::vector<file_system>& left, const std::vector<file_system>& right) const;
+
+		void update_probes(const std::vector<file_system>& systems);
+		void probe_file_systems(const std::vector<file_system>& systems);
 
 	};
 
@@ -0,0 +1,97 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_MOUNT_PROBE_H
+#define VIKKI_MOUNT_PROBE_H
+
+#include <cstdint>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace vikki
+{
+	struct file_system_info
+	{
+		uint64_t total;
+		uint64_t free;
+		uint64_t avail;
+		uint64_t files;
+		uint64_t free_files;
+	};
+
+	class mount_probe
+	{
+	public:
+		enum class status
+		{
+			fresh,
+			stale,
+			missing
+		};
+
+		explicit mount_probe(const std::string& dir);
+		~mount_probe();
+
+		mount_probe(const mount_probe& value) = delete;
+		mount_probe& operator=(const mount_probe& value) = delete;
+
+		const std::string& dir() const;
+
+		void start();
+		bool wait(std::chrono::steady_clock::time_point deadline);
+		status result(file_system_info& info);
+
+	private:
+		struct state
+		{
+			std::mutex mutex;
+			std::condition_variable condition;
+			bool stop;
+			uint64_t requested;
+			uint64_t completed;
+			bool succeeded;
+			bool valid;
+			file_system_info info;
+		};
+
+		std::string _dir;
+		std::shared_ptr<state> _state;
+		std::thread _thread;
+
+		static void pin_module();
+		static void run(std::string dir, std::shared_ptr<state> probe_state);
+		static bool probe(const std::string& dir, file_system_info& info);
+		static uint64_t blocks_to_bytes(uint64_t value, uint64_t bsize);
+
+	};
+}
+
+#endif // VIKKI_MOUNT_PROBE_H
+
@@ -31,23 +31,28 @@ SOFTWARE.
 #include <mntent.h>
 #include <cstring>
 #include <iostream>
-
-#if defined(__FreeBSD__) || defined(__OpenBSD__)
-# include <sys/param.h>
-# include <sys/mount.h>
-#else
-# include <sys/statvfs.h>
-# define VIKKI_STATVFS
-#endif
+#include <ctime>
+#include <algorithm>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 
 namespace vikki
 {
 	file_system_usage_sensor::file_system_usage_sensor()
+		: _mounts_fd(-1), _mounts_valid(false), _generation(static_cast<uint32_t>(std::time(nullptr))),
+		  _mounts_sent(false), _keyframe_interval(20), _keyframe_samples(0), _timeout(1000),
+		  _usages_generation(0), _usages_ready(false)
 	{
+		_mounts_fd = open("/proc/self/mounts", O_RDONLY | O_CLOEXEC);
 	}
 
 	file_system_usage_sensor::~file_system_usage_sensor()
 	{
+		if (_mounts_fd >= 0)
+		{
+			close(_mounts_fd);
+		}
 	}
 
 	std::string file_system_usage_sensor::name() const
@@ -55,94 +60,109 @@ namespace vikki
 		return "file_system_usage";
 	}
 
-	std::vector<char> file_system_usage_sensor::data()
+	size_t file_system_usage_sensor::sample(char *buffer, size_t capacity)
 	{
-		uint64_t size = 0;
+		const std::vector<file_system>& systems = file_system_list();
 
-		std::vector<file_system> systems = get_file_system_list();
-		size += sizeof(uint64_t);
-
-		for (const file_system& system : systems)
+		if (!_usages_ready || _usages_generation != _generation)
 		{
-			size += sizeof(uint64_t);
-			size += system.dir.size();
+			probe_file_systems(systems);
 
-			size += sizeof(uint64_t);
-			size += system.device.size();
+			_usages_generation = _generation;
+			_usages_ready = true;
+		}
 
-			size += sizeof(uint64_t);
-			size += system.type.size();
+		const bool keyframe = !_mounts_sent || _keyframe_samples + 1 >= _keyframe_interval;
+		const std::vector<file_system> *mounts = keyframe ? &systems : nullptr;
 
-			size += sizeof(uint64_t);
-			size += system.options.size();
+		const size_t size = file_system_usage_payload::size(mounts, _usages.size());
 
-			size += sizeof(uint64_t) * 5;
+		if (capacity < size)
+		{
+			return size;
 		}
 
-		std::vector<char> result(size);
-		char *p = result.data();
+		payload::writer out(buffer);
 
-		*reinterpret_cast<uint64_t*>(p) = systems.size();
-		p += sizeof(uint64_t);
+		file_system_usage_payload::write_header(out, _generation, mounts, _usages.size());
 
-		for (const file_system& system : systems)
+		for (const file_system_usage_payload::usage& usage : _usages)
 		{
-			*reinterpret_cast<uint64_t*>(p) = system.dir.size();
-			p += sizeof(uint64_t);
-
-			std::memcpy(p, system.dir.c_str(), system.dir.size());
-			p += system.dir.size();
-
-			//
+			file_system_usage_payload::write_usage(out, usage);
+		}
 
-			*reinterpret_cast<uint64_t*>(p) = system.device.size();
-			p += sizeof(uint64_t);
+		_usages_ready = false;
 
-			std::memcpy(p, system.device.c_str(), system.device.size());
-			p += system.device.size();
+		if (keyframe)
+		{
+			_mounts_sent = true;
+			_keyframe_samples = 0;
+		}
+		else
+		{
+			++_keyframe_samples;
+		}
 
-			//
+		return out.size();
+	}
 
-			*reinterpret_cast<uint64_t*>(p) = system.type.size();
-			p += sizeof(uint64_t);
+	void file_system_usage_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("keyframe_interval");
+		if (iter != params.end())
+		{
+			_keyframe_interval = std::stoul(iter->second);
+		}
 
-			std::memcpy(p, system.type.c_str(), system.type.size());
-			p += system.type.size();
+		iter = params.find("timeout");
+		if (iter != params.end())
+		{
+			_timeout = std::chrono::milliseconds(std::stoul(iter->second));
+		}
+	}
 
-			//
+	bool file_system_usage_sensor::mounts_changed()
+	{
+		if (_mounts_fd < 0)
+		{
+			return true;
+		}
 
-			*reinterpret_cast<uint64_t*>(p) = system.options.size();
-			p += sizeof(uint64_t);
+		pollfd fd;
 
-			std::memcpy(p, system.options.c_str(), system.options.size());
-			p += system.options.size();
+		fd.fd = _mounts_fd;
+		fd.events = POLLPRI;
+		fd.revents = 0;
 
-			//
+		int status = poll(&fd, 1, 0);
+		if (status < 0)
+		{
+			return true;
+		}
 
-			file_system_info info = get_file_system_info(system.dir);
+		return (fd.revents & (POLLPRI | POLLERR)) != 0;
+	}
 
-			*reinterpret_cast<uint64_t*>(p) = info.total;
-			p += sizeof(uint64_t);
+	const std::vector<file_system_usage_sensor::file_system>& file_system_usage_sensor::file_system_list()
+	{
+		if (mounts_changed() || !_mounts_valid)
+		{
+			_mounts_valid = false;
 
-			*reinterpret_cast<uint64_t*>(p) = info.free;
-			p += sizeof(uint64_t);
+			std::vector<file_system> systems = get_file_system_list();
 
-			*reinterpret_cast<uint64_t*>(p) = info.avail;
-			p += sizeof(uint64_t);
+			if (!same_file_systems(systems, _systems))
+			{
+				_systems.swap(systems);
 
-			*reinterpret_cast<uint64_t*>(p) = info.files;
-			p += sizeof(uint64_t);
+				++_generation;
+				_mounts_sent = false;
+			}
 
-			*reinterpret_cast<uint64_t*>(p) = info.free_files;
-			p += sizeof(uint64_t);
+			_mounts_valid = true;
 		}
 
-		return result;
-	}
-
-	uint64_t file_system_usage_sensor::blocks_to_bytes(uint64_t value, uint64_t bsize) const
-	{
-		return (value * bsize) >> 1;
+		return _systems;
 	}
 
 	std::vector<file_system_usage_sensor::file_system> file_system_usage_sensor::get_file_system_list() const
@@ -185,44 +205,90 @@ namespace vikki
 		return systems;
 	}
 
-	file_system_usage_sensor::file_system_info file_system_usage_sensor::get_file_system_info(const std::string& dir) const
+	bool file_system_usage_sensor::same_file_systems(const std::vector<file_system>& left, const std::vector<file_system>& right) const
 	{
-		file_system_info info;
+		if (left.size() != right.size())
+		{
+			return false;
+		}
+
+		for (size_t i = 0; i < left.size(); ++i)
+		{
+			if (left[i].dir != right[i].dir || left[i].device != right[i].device ||
+				left[i].type != right[i].type || left[i].options != right[i].options)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
 
-#ifdef VIKKI_STATVFS
-		struct statvfs data;
-		int status = statvfs(dir.c_str(), &data);
-#else
-		struct statfs buf;
-		int status = statfs(dir.c_str(), &data);
-#endif
+	void file_system_usage_sensor::update_probes(const std::vector<file_system>& systems)
+	{
+		bool matches = _probes.size() == systems.size();
 
-		if (status != 0)
+		for (size_t i = 0; matches && i < systems.size(); ++i)
 		{
-			throw exception("Can't get information about the filesystems, error code: " + std::to_string(errno));
+			matches = _probes[i]->dir() == systems[i].dir;
 		}
 
-		uint64_t value, bsize;
+		if (matches)
+		{
+			return;
+		}
 
-#ifdef VIKKI_STATVFS_EXISTS
-		bsize = data.f_frsize / 512;
-#else
-		bsize = data.f_bsize / 512;
-#endif
+		std::vector<std::unique_ptr<mount_probe>> probes;
 
-		value = data.f_blocks;
-		info.total = blocks_to_bytes(value, bsize);
+		for (const file_system& system : systems)
+		{
+			auto iter = std::find_if(_probes.begin(), _probes.end(), [&system](const std::unique_ptr<mount_probe>& probe)
+			{
+				return probe != nullptr && probe->dir() == system.dir;
+			});
 
-		value = data.f_bfree;
-		info.free  = blocks_to_bytes(value, bsize);
+			if (iter != _probes.end())
+			{
+				probes.push_back(std::move(*iter));
+			}
+			else
+			{
+				probes.push_back(std::unique_ptr<mount_probe>(new mount_probe(system.dir)));
+			}
+		}
+
+		_probes.swap(probes);
+	}
+
+	void file_system_usage_sensor::probe_file_systems(const std::vector<file_system>& systems)
+	{
+		update_probes(systems);
+
+		for (const std::unique_ptr<mount_probe>& probe : _probes)
+		{
+			probe->start();
+		}
 
-		value = data.f_bavail;
-		info.avail = blocks_to_bytes(value, bsize);
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + _timeout;
 
-		info.files = data.f_files;
-		info.free_files = data.f_ffree;
+		_usages.clear();
 
-		return info;
+		for (size_t i = 0; i < _probes.size(); ++i)
+		{
+			_probes[i]->wait(deadline);
+
+			file_system_info info;
+			mount_probe::status status = _probes[i]->result(info);
+
+			if (status == mount_probe::status::missing)
+			{
+				continue;
+			}
+
+			_usages.push_back(file_system_usage_payload::usage { static_cast<uint32_t>(i), info.total, info.free,
+				info.avail, info.files, info.free_files,
+				static_cast<uint8_t>(status == mount_probe::status::stale ? file_system_usage_payload::stale : 0) });
+		}
 	}
 
 	sensor *create_sensor()
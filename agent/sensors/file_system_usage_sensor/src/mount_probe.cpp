@@ -0,0 +1,232 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "mount_probe.h"
+
+#include <dlfcn.h>
+
+#if defined(__FreeBSD__) || defined(__OpenBSD__)
+# include <sys/param.h>
+# include <sys/mount.h>
+#else
+# include <sys/statvfs.h>
+# define VIKKI_STATVFS
+#endif
+
+namespace vikki
+{
+	mount_probe::mount_probe(const std::string& dir)
+		: _dir(dir), _state(std::make_shared<state>())
+	{
+		_state->stop = false;
+		_state->requested = 0;
+		_state->completed = 0;
+		_state->succeeded = false;
+		_state->valid = false;
+
+		_thread = std::thread(&mount_probe::run, _dir, _state);
+	}
+
+	mount_probe::~mount_probe()
+	{
+		bool idle = false;
+
+		{
+			std::lock_guard<std::mutex> locker(_state->mutex);
+
+			_state->stop = true;
+			idle = _state->completed == _state->requested;
+		}
+
+		_state->condition.notify_all();
+
+		if (!idle)
+		{
+			std::unique_lock<std::mutex> locker(_state->mutex);
+
+			idle = _state->condition.wait_for(locker, std::chrono::milliseconds(100), [this]()
+			{
+				return _state->completed == _state->requested;
+			});
+		}
+
+		if (idle)
+		{
+			_thread.join();
+		}
+		else
+		{
+			// the thread is stuck in statfs and runs code of this plugin,
+			// so the plugin must survive its dlclose until the thread ends
+			pin_module();
+			_thread.detach();
+		}
+	}
+
+	const std::string& mount_probe::dir() const
+	{
+		return _dir;
+	}
+
+	void mount_probe::start()
+	{
+		{
+			std::lock_guard<std::mutex> locker(_state->mutex);
+
+			if (_state->completed != _state->requested)
+			{
+				return;
+			}
+
+			++_state->requested;
+		}
+
+		_state->condition.notify_all();
+	}
+
+	bool mount_probe::wait(std::chrono::steady_clock::time_point deadline)
+	{
+		std::unique_lock<std::mutex> locker(_state->mutex);
+
+		return _state->condition.wait_until(locker, deadline, [this]()
+		{
+			return _state->completed == _state->requested;
+		});
+	}
+
+	mount_probe::status mount_probe::result(file_system_info& info)
+	{
+		std::lock_guard<std::mutex> locker(_state->mutex);
+
+		if (!_state->valid)
+		{
+			return status::missing;
+		}
+
+		info = _state->info;
+
+		if (_state->completed == _state->requested && _state->succeeded)
+		{
+			return status::fresh;
+		}
+
+		return status::stale;
+	}
+
+	void mount_probe::run(std::string dir, std::shared_ptr<state> probe_state)
+	{
+		std::unique_lock<std::mutex> locker(probe_state->mutex);
+
+		while (true)
+		{
+			probe_state->condition.wait(locker, [&probe_state]()
+			{
+				return probe_state->stop || probe_state->completed != probe_state->requested;
+			});
+
+			if (probe_state->stop)
+			{
+				break;
+			}
+
+			const uint64_t request = probe_state->requested;
+
+			locker.unlock();
+
+			file_system_info info;
+			bool succeeded = probe(dir, info);
+
+			locker.lock();
+
+			probe_state->completed = request;
+			probe_state->succeeded = succeeded;
+
+			if (succeeded)
+			{
+				probe_state->info = info;
+				probe_state->valid = true;
+			}
+
+			probe_state->condition.notify_all();
+		}
+	}
+
+	void mount_probe::pin_module()
+	{
+		Dl_info info;
+
+		if (dladdr(reinterpret_cast<void*>(&mount_probe::run), &info) == 0 || info.dli_fname == nullptr)
+		{
+			return;
+		}
+
+		// never released: a hung mount keeps the thread alive until exit
+		dlopen(info.dli_fname, RTLD_NOW | RTLD_NOLOAD | RTLD_NODELETE);
+	}
+
+	bool mount_probe::probe(const std::string& dir, file_system_info& info)
+	{
+#ifdef VIKKI_STATVFS
+		struct statvfs data;
+		int status = statvfs(dir.c_str(), &data);
+#else
+		struct statfs data;
+		int status = statfs(dir.c_str(), &data);
+#endif
+
+		if (status != 0)
+		{
+			return false;
+		}
+
+		uint64_t value, bsize;
+
+#ifdef VIKKI_STATVFS_EXISTS
+		bsize = data.f_frsize / 512;
+#else
+		bsize = data.f_bsize / 512;
+#endif
+
+		value = data.f_blocks;
+		info.total = blocks_to_bytes(value, bsize);
+
+		value = data.f_bfree;
+		info.free  = blocks_to_bytes(value, bsize);
+
+		value = data.f_bavail;
+		info.avail = blocks_to_bytes(value, bsize);
+
+		info.files = data.f_files;
+		info.free_files = data.f_ffree;
+
+		return true;
+	}
+
+	uint64_t mount_probe::blocks_to_bytes(uint64_t value, uint64_t bsize)
+	{
+		return (value * bsize) >> 1;
+	}
+}
@@ -0,0 +1,99 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_KV_FILE_SENSOR_H
+#define VIKKI_KV_FILE_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "param_list.h"
+#include "procfs_reader.h"
+
+#include <memory>
+
+namespace vikki
+{
+	class kv_file_sensor
+		: public sensor
+	{
+	public:
+		kv_file_sensor();
+		~kv_file_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum class parse_mode
+		{
+			key_value,
+			table
+		};
+
+		struct field_source
+		{
+			std::string key;
+			size_t row;
+			size_t column;
+			size_t offset;
+		};
+
+		struct extract_step
+		{
+			size_t line;
+			size_t field;
+		};
+
+		std::unique_ptr<procfs_reader> _file;
+		parse_mode _mode;
+		sensor_schema _fields;
+		std::vector<field_source> _sources;
+		size_t _size;
+
+		std::vector<extract_step> _plan;
+
+		void build_plan(const char *data, size_t size);
+		void check_plan(const char *data, size_t size) const;
+		bool extract(const char *data, size_t size, char *buffer) const;
+		void write_value(size_t field, const char *text, char *buffer) const;
+
+		static bool is_separator(char c);
+		static std::string field_name(const std::string& source);
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_KV_FILE_SENSOR_H
+
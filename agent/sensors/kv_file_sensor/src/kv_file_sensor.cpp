@@ -0,0 +1,363 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "kv_file_sensor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+namespace vikki
+{
+	kv_file_sensor::kv_file_sensor()
+		: _mode(parse_mode::key_value), _size(0)
+	{
+	}
+
+	kv_file_sensor::~kv_file_sensor()
+	{
+	}
+
+	std::string kv_file_sensor::name() const
+	{
+		return "kv_file";
+	}
+
+	size_t kv_file_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (_file == nullptr || _size == 0)
+		{
+			return 0;
+		}
+
+		if (capacity < _size)
+		{
+			return _size;
+		}
+
+		const char *data = _file->read();
+		const size_t size = _file->size();
+
+		// lines moved since the plan was made, e.g. a kernel module added entries
+		if (!extract(data, size, buffer))
+		{
+			build_plan(data, size);
+			extract(data, size, buffer);
+		}
+
+		return _size;
+	}
+
+	sensor_schema kv_file_sensor::schema() const
+	{
+		return _fields;
+	}
+
+	void kv_file_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("path");
+		if (iter == params.end())
+		{
+			throw exception("Can't initialize kv_file sensor: \"path\" param is missing");
+		}
+
+		_file.reset(new procfs_reader(iter->second));
+
+		iter = params.find("mode");
+		if (iter != params.end())
+		{
+			if (iter->second == "key_value")
+			{
+				_mode = parse_mode::key_value;
+			}
+			else if (iter->second == "table")
+			{
+				_mode = parse_mode::table;
+			}
+			else
+			{
+				throw exception("Can't use kv_file mode \"" + iter->second + "\": mode doesn't exist");
+			}
+		}
+
+		iter = params.find("fields");
+		if (iter != params.end())
+		{
+			for (std::string spec : split_param_list(iter->second))
+			{
+				// "[name=]source[:type]", the source is a key or "row.column" of the table
+				std::string name;
+
+				const size_t equals = spec.find('=');
+				if (equals != std::string::npos)
+				{
+					name = spec.substr(0, equals);
+					spec.erase(0, equals + 1);
+				}
+
+				sensor_field field = parse_sensor_field(spec, value_type::uint64);
+				field_source source { field.name, 0, 0, _size };
+
+				if (_mode == parse_mode::table)
+				{
+					char *end = nullptr;
+
+					source.row = std::strtoul(field.name.c_str(), &end, 10);
+
+					if (*end != '.')
+					{
+						throw exception("Can't parse kv_file field \"" + spec + "\": source must be \"row.column\"");
+					}
+
+					source.column = std::strtoul(end + 1, nullptr, 10);
+				}
+
+				field.name = name.empty() ? field_name(field.name) : name;
+
+				_size += value_size(field.type);
+
+				_fields.push_back(field);
+				_sources.push_back(source);
+			}
+		}
+
+		// the file is read once here, so a wrong path or source fails the start instead of every sample
+		const char *data = _file->read();
+		const size_t size = _file->size();
+
+		build_plan(data, size);
+		check_plan(data, size);
+	}
+
+	void kv_file_sensor::build_plan(const char *data, size_t size)
+	{
+		_plan.clear();
+
+		if (_mode == parse_mode::table)
+		{
+			for (size_t i = 0; i < _sources.size(); ++i)
+			{
+				_plan.push_back(extract_step { _sources[i].row, i });
+			}
+		}
+		else
+		{
+			const char *p = data;
+			const char *end = data + size;
+
+			for (size_t line = 0; p < end; ++line)
+			{
+				const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+				if (eol == nullptr)
+				{
+					eol = end;
+				}
+
+				const char *key_end = p;
+
+				while (key_end < eol && !is_separator(*key_end))
+				{
+					++key_end;
+				}
+
+				for (size_t i = 0; i < _sources.size(); ++i)
+				{
+					const std::string& key = _sources[i].key;
+
+					if (key.size() == static_cast<size_t>(key_end - p) && key.compare(0, key.size(), p, key.size()) == 0)
+					{
+						_plan.push_back(extract_step { line, i });
+					}
+				}
+
+				p = eol + 1;
+			}
+		}
+
+		std::stable_sort(_plan.begin(), _plan.end(), [](const extract_step& left, const extract_step& right)
+		{
+			return left.line < right.line;
+		});
+	}
+
+	void kv_file_sensor::check_plan(const char *data, size_t size) const
+	{
+		const size_t lines = static_cast<size_t>(std::count(data, data + size, '\n')) +
+			(size > 0 && data[size - 1] != '\n' ? 1 : 0);
+
+		for (size_t i = 0; i < _sources.size(); ++i)
+		{
+			auto step = std::find_if(_plan.begin(), _plan.end(), [i](const extract_step& value)
+			{
+				return value.field == i;
+			});
+
+			if (step == _plan.end() || step->line >= lines)
+			{
+				throw exception("Can't find kv_file field \"" + _fields[i].name + "\" in " + _file->path());
+			}
+		}
+	}
+
+	bool kv_file_sensor::extract(const char *data, size_t size, char *buffer) const
+	{
+		std::memset(buffer, 0, _size);
+
+		const char *p = data;
+		const char *end = data + size;
+
+		auto step = _plan.begin();
+
+		for (size_t line = 0; step != _plan.end() && p < end; ++line)
+		{
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (eol == nullptr)
+			{
+				eol = end;
+			}
+
+			for (; step != _plan.end() && step->line == line; ++step)
+			{
+				const field_source& source = _sources[step->field];
+
+				if (_mode == parse_mode::key_value)
+				{
+					const size_t key_size = source.key.size();
+
+					if (static_cast<size_t>(eol - p) <= key_size || std::memcmp(p, source.key.data(), key_size) != 0 ||
+						!is_separator(p[key_size]))
+					{
+						return false;
+					}
+
+					write_value(step->field, p + key_size, buffer);
+				}
+				else
+				{
+					const char *token = p;
+
+					for (size_t column = 0; token < eol; ++column)
+					{
+						while (token < eol && (*token == ' ' || *token == '\t'))
+						{
+							++token;
+						}
+
+						if (column == source.column || token == eol)
+						{
+							break;
+						}
+
+						while (token < eol && *token != ' ' && *token != '\t')
+						{
+							++token;
+						}
+					}
+
+					if (token < eol)
+					{
+						write_value(step->field, token, buffer);
+					}
+				}
+			}
+
+			p = eol + 1;
+		}
+
+		return true;
+	}
+
+	void kv_file_sensor::write_value(size_t field, const char *text, char *buffer) const
+	{
+		while (is_separator(*text))
+		{
+			++text;
+		}
+
+		char *p = buffer + _sources[field].offset;
+		char *end = nullptr;
+
+		switch (_fields[field].type)
+		{
+		case value_type::int64:
+		{
+			int64_t value = std::strtoll(text, &end, 10);
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+
+		case value_type::uint64:
+		{
+			uint64_t value = std::strtoull(text, &end, 10);
+
+			// meminfo style sizes
+			if (std::strncmp(end, " kB", 3) == 0)
+			{
+				value *= 1024;
+			}
+
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+
+		case value_type::float64:
+		{
+			double value = std::strtod(text, &end);
+			std::memcpy(p, &value, sizeof(value));
+			break;
+		}
+		}
+	}
+
+	bool kv_file_sensor::is_separator(char c)
+	{
+		return c == ':' || c == '=' || c == ' ' || c == '\t';
+	}
+
+	std::string kv_file_sensor::field_name(const std::string& source)
+	{
+		std::string result;
+
+		for (char c : source)
+		{
+			result += std::isalnum(static_cast<unsigned char>(c)) != 0
+				? static_cast<char>(std::tolower(static_cast<unsigned char>(c))) : '_';
+		}
+
+		return result;
+	}
+
+	sensor *create_sensor()
+	{
+		return new kv_file_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
@@ -29,6 +29,7 @@ SOFTWARE.
 
 #include "exception.h"
 #include "sensor.h"
+#include "procfs_reader.h"
 
 namespace vikki
 {
@@ -40,7 +41,12 @@ namespace vikki
 		~load_average_sensor() override;
 
 		std::string name() const override;
-		std::vector<char> data() override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+		bool fixed_layout() const override;
+
+	private:
+		procfs_reader _loadavg;
 
 	};
 
@@ -25,10 +25,7 @@ SOFTWARE.
 */
 
 #include "load_average_sensor.h"
-
-#include <fcntl.h>
-#include <unistd.h>
-#include <cstring>
+#include "load_average_payload.h"
 
 #include <cstdlib>
 #include <cerrno>
@@ -36,6 +33,7 @@ SOFTWARE.
 namespace vikki
 {
 	load_average_sensor::load_average_sensor()
+		: _loadavg("/proc/loadavg")
 	{
 	}
 
@@ -48,44 +46,33 @@ namespace vikki
 		return "load_average";
 	}
 
-	std::vector<char> load_average_sensor::data()
+	size_t load_average_sensor::sample(char *buffer, size_t capacity)
 	{
-		int fd = open("/proc/loadavg", O_RDONLY);
-		if (fd < 0)
+		if (capacity < load_average_payload::size())
 		{
-			throw exception("Can't open /proc/loadavg, error code: " + std::to_string(errno));
+			return load_average_payload::size();
 		}
 
-		char buffer[8192];
-		char *pbuff = buffer;
-
-		int len = read(fd, buffer, sizeof(buffer));
-		if (len < 0)
-		{
-			close(fd);
-
-			throw exception("Can't read /proc/loadavg, error code: " + std::to_string(errno));
-		}
+		const char *loadavg = _loadavg.read();
+		char *pbuff = nullptr;
 
-		double la1 = strtod(pbuff, &pbuff);
+		double la1 = strtod(loadavg, &pbuff);
 		double la5 = strtod(pbuff, &pbuff);
 		double la15 = strtod(pbuff, &pbuff);
 
-		std::vector<char> result(sizeof(double) * 3);
-
-		void *ptr = result.data();
+		load_average_payload::encode(buffer, la1, la5, la15);
 
-		write_data<double>(ptr, la1, &ptr);
-		write_data<double>(ptr, la5, &ptr);
-		write_data<double>(ptr, la15, &ptr);
+		return load_average_payload::size();
+	}
 
-		int err = close(fd);
-		if (err < 0)
-		{
-			throw exception("Can't close /proc/loadavg, error code: " + std::to_string(errno));
-		}
+	sensor_schema load_average_sensor::schema() const
+	{
+		return payload_schema<load_average_payload>();
+	}
 
-		return result;
+	bool load_average_sensor::fixed_layout() const
+	{
+		return true;
 	}
 
 	sensor *create_sensor()
@@ -0,0 +1,89 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_LOG_PATTERN_SENSOR_H
+#define VIKKI_LOG_PATTERN_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "param_list.h"
+
+#include <sys/types.h>
+
+namespace vikki
+{
+	class log_pattern_sensor
+		: public sensor
+	{
+	public:
+		log_pattern_sensor();
+		~log_pattern_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		struct log_file
+		{
+			std::string path;
+			std::string name;
+			int fd;
+			int watch;
+			dev_t device;
+			ino_t inode;
+			bool check;
+			std::vector<char> partial;
+		};
+
+		int _inotify;
+		std::vector<log_file> _files;
+		std::vector<std::string> _patterns;
+		std::vector<uint64_t> _counts;
+
+		std::vector<char> _buffer;
+
+		void read_events();
+		void follow(log_file& file, bool from_start);
+		void check_rotation(log_file& file);
+		void read_file(log_file& file);
+		void scan(const char *data, size_t size);
+
+		static std::string field_name(const std::string& pattern);
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_LOG_PATTERN_SENSOR_H
+
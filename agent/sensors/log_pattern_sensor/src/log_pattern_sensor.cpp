@@ -0,0 +1,364 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "log_pattern_sensor.h"
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+namespace vikki
+{
+	log_pattern_sensor::log_pattern_sensor()
+		: _inotify(-1), _buffer(65536)
+	{
+	}
+
+	log_pattern_sensor::~log_pattern_sensor()
+	{
+		for (const log_file& file : _files)
+		{
+			if (file.fd != -1)
+			{
+				close(file.fd);
+			}
+		}
+
+		if (_inotify != -1)
+		{
+			close(_inotify);
+		}
+	}
+
+	std::string log_pattern_sensor::name() const
+	{
+		return "log_pattern";
+	}
+
+	size_t log_pattern_sensor::sample(char *buffer, size_t capacity)
+	{
+		const size_t size = _counts.size() * sizeof(uint64_t);
+
+		if (size == 0)
+		{
+			return 0;
+		}
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		read_events();
+
+		for (log_file& file : _files)
+		{
+			// without a directory watch rotation can only be noticed by polling
+			if (file.check || file.watch == -1)
+			{
+				file.check = false;
+
+				check_rotation(file);
+			}
+
+			read_file(file);
+		}
+
+		std::memcpy(buffer, _counts.data(), size);
+		std::fill(_counts.begin(), _counts.end(), 0);
+
+		return size;
+	}
+
+	sensor_schema log_pattern_sensor::schema() const
+	{
+		sensor_schema result;
+
+		for (const std::string& pattern : _patterns)
+		{
+			result.push_back(sensor_field { field_name(pattern), value_type::uint64, field_kind::gauge });
+		}
+
+		return result;
+	}
+
+	void log_pattern_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (_inotify == -1)
+		{
+			throw exception("Can't initialize inotify, error code: " + std::to_string(errno));
+		}
+
+		auto iter = params.find("patterns");
+		if (iter != params.end())
+		{
+			_patterns = split_param_list(iter->second);
+			_counts.assign(_patterns.size(), 0);
+		}
+
+		iter = params.find("files");
+		if (iter != params.end())
+		{
+			for (const std::string& path : split_param_list(iter->second))
+			{
+				log_file file;
+
+				const size_t slash = path.rfind('/');
+				const std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+
+				file.path = path;
+				file.name = slash == std::string::npos ? path : path.substr(slash + 1);
+				file.fd = -1;
+				file.watch = inotify_add_watch(_inotify, directory.c_str(),
+					IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR);
+				file.device = 0;
+				file.inode = 0;
+				file.check = false;
+
+				// existing content is history, only lines written from now on are counted
+				follow(file, false);
+
+				_files.push_back(file);
+			}
+		}
+	}
+
+	void log_pattern_sensor::read_events()
+	{
+		char events[4096];
+
+		while (true)
+		{
+			ssize_t len = read(_inotify, events, sizeof(events));
+
+			if (len < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (len <= 0)
+			{
+				break;
+			}
+
+			for (ssize_t offset = 0; offset < len; )
+			{
+				inotify_event event;
+				std::memcpy(&event, events + offset, sizeof(event));
+
+				const char *name = events + offset + sizeof(event);
+
+				for (log_file& file : _files)
+				{
+					if ((event.mask & IN_Q_OVERFLOW) != 0 ||
+						(event.wd == file.watch && event.len > 0 && file.name == name))
+					{
+						file.check = true;
+					}
+				}
+
+				offset += sizeof(event) + event.len;
+			}
+		}
+	}
+
+	void log_pattern_sensor::follow(log_file& file, bool from_start)
+	{
+		file.partial.clear();
+
+		file.fd = open(file.path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (file.fd == -1)
+		{
+			return;
+		}
+
+		struct stat st;
+
+		if (fstat(file.fd, &st) == 0)
+		{
+			file.device = st.st_dev;
+			file.inode = st.st_ino;
+		}
+
+		if (!from_start)
+		{
+			lseek(file.fd, 0, SEEK_END);
+		}
+	}
+
+	void log_pattern_sensor::check_rotation(log_file& file)
+	{
+		struct stat st;
+
+		// keep reading a removed file until something takes its name
+		if (stat(file.path.c_str(), &st) != 0)
+		{
+			return;
+		}
+
+		if (file.fd != -1 && st.st_dev == file.device && st.st_ino == file.inode)
+		{
+			return;
+		}
+
+		if (file.fd != -1)
+		{
+			// lines written just before the rotation are still counted
+			read_file(file);
+
+			close(file.fd);
+			file.fd = -1;
+		}
+
+		follow(file, true);
+	}
+
+	void log_pattern_sensor::read_file(log_file& file)
+	{
+		if (file.fd == -1)
+		{
+			return;
+		}
+
+		struct stat st;
+
+		// a file truncated in place (copytruncate) is read again from the beginning
+		if (fstat(file.fd, &st) == 0 && st.st_size < lseek(file.fd, 0, SEEK_CUR))
+		{
+			lseek(file.fd, 0, SEEK_SET);
+
+			file.partial.clear();
+		}
+
+		char *data = _buffer.data();
+		size_t size = file.partial.size();
+
+		std::memcpy(data, file.partial.data(), size);
+
+		while (true)
+		{
+			ssize_t len = read(file.fd, data + size, _buffer.size() - size);
+
+			if (len < 0 && errno == EINTR)
+			{
+				continue;
+			}
+
+			if (len <= 0)
+			{
+				break;
+			}
+
+			size += len;
+
+			// only complete lines are scanned, the tail waits for its newline
+			const char *last = static_cast<const char*>(memrchr(data, '\n', size));
+			if (last == nullptr)
+			{
+				if (size == _buffer.size())
+				{
+					scan(data, size);
+
+					size = 0;
+				}
+
+				continue;
+			}
+
+			const size_t complete = last - data + 1;
+
+			scan(data, complete);
+
+			std::memmove(data, data + complete, size - complete);
+			size -= complete;
+		}
+
+		file.partial.assign(data, data + size);
+	}
+
+	void log_pattern_sensor::scan(const char *data, size_t size)
+	{
+		const char *end = data + size;
+
+		// memchr is vectorized, so the first byte of a pattern is located a block at a time
+		for (size_t i = 0; i < _patterns.size(); ++i)
+		{
+			const std::string& pattern = _patterns[i];
+			const size_t rest = pattern.size() - 1;
+			const char *p = data;
+
+			while (static_cast<size_t>(end - p) > rest)
+			{
+				p = static_cast<const char*>(std::memchr(p, pattern[0], end - p - rest));
+				if (p == nullptr)
+				{
+					break;
+				}
+
+				if (std::memcmp(p + 1, pattern.data() + 1, rest) == 0)
+				{
+					++_counts[i];
+
+					p += pattern.size();
+				}
+				else
+				{
+					++p;
+				}
+			}
+		}
+	}
+
+	std::string log_pattern_sensor::field_name(const std::string& pattern)
+	{
+		std::string result;
+
+		for (char c : pattern)
+		{
+			result += std::isalnum(static_cast<unsigned char>(c)) != 0
+				? static_cast<char>(std::tolower(static_cast<unsigned char>(c))) : '_';
+		}
+
+		return result;
+	}
+
+	sensor *create_sensor()
+	{
+		return new log_pattern_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
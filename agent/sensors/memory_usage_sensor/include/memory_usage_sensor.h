@@ -29,6 +29,9 @@ SOFTWARE.
 
 #include "exception.h"
 #include "sensor.h"
+#include "param_list.h"
+#include "procfs_reader.h"
+#include "procfs_table.h"
 
 namespace vikki
 {
@@ -40,10 +43,19 @@ namespace vikki
 		~memory_usage_sensor() override;
 
 		std::string name() const override;
-		std::vector<char> data() override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+		bool fixed_layout() const override;
+
+		void init(const std::map<std::string, std::string>& params) override;
 
 	private:
-		uint64_t parse_mem_param(char *buffer, const char *attr) const;
+		procfs_reader _meminfo;
+		procfs_table _table;
+		std::vector<uint64_t> _values;
+
+		static std::vector<std::string> default_fields();
+		static std::string field_name(const std::string& key);
 
 	};
 
@@ -25,17 +25,16 @@ SOFTWARE.
 */
 
 #include "memory_usage_sensor.h"
+#include "memory_usage_payload.h"
 
-#include <fcntl.h>
-#include <unistd.h>
-#include <string.h>
-
-#include <cstdlib>
-#include <cerrno>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
 
 namespace vikki
 {
 	memory_usage_sensor::memory_usage_sensor()
+		: _meminfo("/proc/meminfo"), _table(default_fields()), _values(_table.size())
 	{
 	}
 
@@ -48,81 +47,90 @@ namespace vikki
 		return "memory_usage";
 	}
 
-	std::vector<char> memory_usage_sensor::data()
+	size_t memory_usage_sensor::sample(char *buffer, size_t capacity)
 	{
-		int fd = open("/proc/meminfo", O_RDONLY);
-		if (fd < 0)
-		{
-			throw exception("Can't open /proc/meminfo, error code: " + std::to_string(errno));
-		}
+		const size_t size = _values.size() * sizeof(uint64_t);
 
-		char buffer[8192];
-
-		int len = read(fd, buffer, sizeof(buffer));		
-		if (len < 0)
+		if (capacity < size)
 		{
-			throw exception("Can't read /proc/meminfo, error code: " + std::to_string(errno));
+			return size;
 		}
 
-		uint64_t total = parse_mem_param(buffer, "MemTotal:");
-		uint64_t free = parse_mem_param(buffer, "MemFree:");
-
-		uint64_t buffers = parse_mem_param(buffer, "Buffers:");
-		uint64_t cached = parse_mem_param(buffer, "Cached:");
-
-		uint64_t swap_total = parse_mem_param(buffer, "SwapTotal:");
-		uint64_t swap_free = parse_mem_param(buffer, "SwapFree:");
+		const char *meminfo = _meminfo.read();
 
-		std::vector<char> result(sizeof(uint64_t) * 6);
+		_table.parse(meminfo, _meminfo.size(), _values.data());
 
-		void *ptr = result.data();
+		memory_usage_payload::encode(buffer, _values[0], _values[1], _values[2], _values[3],
+			_values[4], _values[5], _values[6]);
 
-		write_data<uint64_t>(ptr, total, &ptr);
-		write_data<uint64_t>(ptr, free, &ptr);
+		std::memcpy(buffer + memory_usage_payload::size(), _values.data() + memory_usage_payload::count(),
+			size - memory_usage_payload::size());
 
-		write_data<uint64_t>(ptr, buffers, &ptr);
-		write_data<uint64_t>(ptr, cached, &ptr);
+		return size;
+	}
 
-		write_data<uint64_t>(ptr, swap_total, &ptr);
-		write_data<uint64_t>(ptr, swap_free, &ptr);
+	sensor_schema memory_usage_sensor::schema() const
+	{
+		sensor_schema result = payload_schema<memory_usage_payload>();
 
-		int err = close(fd);
-		if (err < 0)
+		for (size_t i = memory_usage_payload::count(); i < _table.size(); ++i)
 		{
-			throw exception("Can't close /proc/loadavg, error code: " + std::to_string(errno));
+			result.push_back(sensor_field { field_name(_table.key(i)), value_type::uint64, field_kind::gauge });
 		}
 
 		return result;
 	}
 
-	uint64_t memory_usage_sensor::parse_mem_param(char *buffer, const char *attr) const
+	bool memory_usage_sensor::fixed_layout() const
 	{
-		int len = strlen(attr);
+		return true;
+	}
 
-		uint64_t val = 0;
-		char *ptr, *tok;
+	void memory_usage_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		std::vector<std::string> fields = default_fields();
 
-		if ((ptr = strstr(buffer, attr)))
+		auto iter = params.find("fields");
+		if (iter != params.end())
 		{
-			ptr += len;
-			val = strtoull(ptr, &tok, 0);
-
-			while (*tok == ' ')
+			for (const std::string& field : split_param_list(iter->second))
 			{
-				++tok;
+				if (std::find(fields.begin(), fields.end(), field) != fields.end())
+				{
+					continue;
+				}
+
+				fields.push_back(field);
 			}
+		}
+
+		_table = procfs_table(fields);
+		_values.assign(_table.size(), 0);
+	}
 
-			if (*tok == 'k')
+	std::vector<std::string> memory_usage_sensor::default_fields()
+	{
+		return std::vector<std::string> { "MemTotal", "MemFree", "Buffers", "Cached", "SwapTotal", "SwapFree",
+			"MemAvailable" };
+	}
+
+	std::string memory_usage_sensor::field_name(const std::string& key)
+	{
+		std::string result;
+
+		for (char c : key)
+		{
+			if (c == '(')
 			{
-				val *= 1024;
+				result += '_';
 			}
-			else if (*tok == 'M')
+			else if (c != ')')
 			{
-				val *= (1024 * 1024);
+				result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
 			}
 		}
 
-		return val;
+		return result;
 	}
 
 	sensor *create_sensor()
@@ -0,0 +1,95 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_NETWORK_INTERFACE_SENSOR_H
+#define VIKKI_NETWORK_INTERFACE_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "param_list.h"
+#include "procfs_reader.h"
+
+#include <net/if.h>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace vikki
+{
+	class network_interface_sensor
+		: public sensor
+	{
+	public:
+		network_interface_sensor();
+		~network_interface_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum
+		{
+			counter_count = 8
+		};
+
+		struct interface_counters
+		{
+			uint64_t values[counter_count];
+			uint64_t generation;
+		};
+
+		struct interface_rates
+		{
+			char name[IFNAMSIZ];
+			uint8_t name_size;
+			double values[counter_count];
+		};
+
+		procfs_reader _dev;
+		name_filter _filter;
+
+		std::unordered_map<std::string, interface_counters> _counters;
+		std::vector<interface_rates> _rates;
+		std::string _key;
+		uint64_t _generation;
+		std::chrono::steady_clock::time_point _time;
+		bool _rates_ready;
+
+		void parse_dev();
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_NETWORK_INTERFACE_SENSOR_H
+
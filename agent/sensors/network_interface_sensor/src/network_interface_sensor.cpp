@@ -0,0 +1,234 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "network_interface_sensor.h"
+#include "network_interface_payload.h"
+
+#include <cstring>
+
+namespace vikki
+{
+	network_interface_sensor::network_interface_sensor()
+		: _dev("/proc/net/dev", 65536), _generation(0), _time(std::chrono::steady_clock::now()), _rates_ready(false)
+	{
+		_key.reserve(IFNAMSIZ);
+	}
+
+	network_interface_sensor::~network_interface_sensor()
+	{
+	}
+
+	std::string network_interface_sensor::name() const
+	{
+		return "network_interface";
+	}
+
+	size_t network_interface_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (!_rates_ready)
+		{
+			parse_dev();
+
+			_rates_ready = true;
+		}
+
+		if (_rates.empty())
+		{
+			_rates_ready = false;
+
+			return 0;
+		}
+
+		size_t size = network_interface_payload::header_size();
+
+		for (const interface_rates& rates : _rates)
+		{
+			size += network_interface_payload::entry_size(rates.name_size);
+		}
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		payload::writer out(buffer);
+
+		network_interface_payload::write_header(out, static_cast<uint32_t>(_rates.size()));
+
+		for (const interface_rates& rates : _rates)
+		{
+			char *entry = network_interface_payload::write_entry(out, rates.name, rates.name_size);
+
+			network_interface_payload::encode(entry, rates.values[0], rates.values[1], rates.values[2], rates.values[3],
+				rates.values[4], rates.values[5], rates.values[6], rates.values[7]);
+		}
+
+		_rates_ready = false;
+
+		return out.size();
+	}
+
+	void network_interface_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		_filter.init(params);
+	}
+
+	void network_interface_sensor::parse_dev()
+	{
+		const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+		const double elapsed = std::chrono::duration<double>(time - _time).count();
+
+		_time = time;
+		++_generation;
+
+		_rates.clear();
+
+		const char *p = _dev.read();
+		const char *end = p + _dev.size();
+
+		for (int i = 0; i < 2 && p < end; ++i)
+		{
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			p = eol != nullptr ? eol + 1 : end;
+		}
+
+		while (p < end)
+		{
+			const char *eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+			if (eol == nullptr)
+			{
+				eol = end;
+			}
+
+			while (p < eol && *p == ' ')
+			{
+				++p;
+			}
+
+			const char *colon = static_cast<const char*>(std::memchr(p, ':', eol - p));
+			const size_t name_size = colon != nullptr ? colon - p : 0;
+
+			if (name_size == 0 || name_size >= IFNAMSIZ)
+			{
+				p = eol + 1;
+
+				continue;
+			}
+
+			char interface[IFNAMSIZ];
+
+			std::memcpy(interface, p, name_size);
+			interface[name_size] = '\0';
+
+			if (!_filter.accepted(interface))
+			{
+				p = eol + 1;
+
+				continue;
+			}
+
+			uint64_t columns[16] = { 0 };
+
+			p = colon + 1;
+
+			for (size_t i = 0; i < 16; ++i)
+			{
+				while (p < eol && *p == ' ')
+				{
+					++p;
+				}
+
+				while (p < eol && *p >= '0' && *p <= '9')
+				{
+					columns[i] = columns[i] * 10 + (*p - '0');
+					++p;
+				}
+			}
+
+			const uint64_t values[counter_count] = { columns[0], columns[1], columns[2], columns[3],
+				columns[8], columns[9], columns[10], columns[11] };
+
+			_key.assign(interface, name_size);
+
+			auto iter = _counters.find(_key);
+			if (iter == _counters.end())
+			{
+				interface_counters counters;
+
+				std::memcpy(counters.values, values, sizeof(values));
+				counters.generation = _generation;
+
+				_counters.insert(std::make_pair(_key, counters));
+			}
+			else
+			{
+				interface_counters& counters = iter->second;
+
+				if (elapsed > 0.0)
+				{
+					interface_rates rates;
+
+					std::memcpy(rates.name, interface, name_size);
+					rates.name_size = static_cast<uint8_t>(name_size);
+
+					for (size_t i = 0; i < counter_count; ++i)
+					{
+						rates.values[i] = values[i] >= counters.values[i] ? (values[i] - counters.values[i]) / elapsed : 0.0;
+					}
+
+					_rates.push_back(rates);
+				}
+
+				std::memcpy(counters.values, values, sizeof(values));
+				counters.generation = _generation;
+			}
+
+			p = eol + 1;
+		}
+
+		for (auto iter = _counters.begin(); iter != _counters.end(); )
+		{
+			if (iter->second.generation != _generation)
+			{
+				iter = _counters.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
+
+	sensor *create_sensor()
+	{
+		return new network_interface_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
@@ -0,0 +1,68 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_PRESSURE_SENSOR_H
+#define VIKKI_PRESSURE_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "procfs_reader.h"
+
+#include <chrono>
+
+namespace vikki
+{
+	class pressure_sensor
+		: public sensor
+	{
+	public:
+		pressure_sensor();
+		~pressure_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+		bool fixed_layout() const override;
+
+	private:
+		procfs_reader _cpu;
+		procfs_reader _memory;
+		procfs_reader _io;
+		bool _available;
+		std::chrono::steady_clock::time_point _retry_time;
+		std::chrono::seconds _backoff;
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_PRESSURE_SENSOR_H
+
@@ -0,0 +1,194 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "pressure_sensor.h"
+#include "pressure_payload.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace vikki
+{
+	namespace
+	{
+		// parses "some avg10=0.00 avg60=0.00 avg300=0.00 total=0" and the matching "full" line
+		void parse_pressure(const char *data, pressure_payload::stall& some, pressure_payload::stall& full)
+		{
+			some = pressure_payload::stall { 0.0, 0.0, 0.0, 0 };
+			full = pressure_payload::stall { 0.0, 0.0, 0.0, 0 };
+
+			const char *line = data;
+
+			while (*line != '\0')
+			{
+				pressure_payload::stall *stall = nullptr;
+
+				if (std::strncmp(line, "some ", 5) == 0)
+				{
+					stall = &some;
+				}
+				else if (std::strncmp(line, "full ", 5) == 0)
+				{
+					stall = &full;
+				}
+
+				if (stall != nullptr)
+				{
+					const char *p = line;
+					char *end = nullptr;
+
+					double *averages[] = { &stall->avg10, &stall->avg60, &stall->avg300 };
+
+					for (double *average : averages)
+					{
+						p = std::strchr(p, '=');
+						if (p == nullptr)
+						{
+							return;
+						}
+
+						*average = std::strtod(p + 1, &end);
+						p = end;
+					}
+
+					p = std::strchr(p, '=');
+					if (p == nullptr)
+					{
+						return;
+					}
+
+					stall->total = std::strtoull(p + 1, &end, 10);
+				}
+
+				line = std::strchr(line, '\n');
+				if (line == nullptr)
+				{
+					break;
+				}
+
+				++line;
+			}
+		}
+	}
+
+	pressure_sensor::pressure_sensor()
+		: _cpu("/proc/pressure/cpu", 256), _memory("/proc/pressure/memory", 256), _io("/proc/pressure/io", 256),
+		  _available(true), _retry_time(std::chrono::steady_clock::now()), _backoff(1)
+	{
+	}
+
+	pressure_sensor::~pressure_sensor()
+	{
+	}
+
+	std::string pressure_sensor::name() const
+	{
+		return "pressure";
+	}
+
+	size_t pressure_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (capacity < pressure_payload::size())
+		{
+			return pressure_payload::size();
+		}
+
+		if (!_available && std::chrono::steady_clock::now() < _retry_time)
+		{
+			return 0;
+		}
+
+		pressure_payload::stall some;
+		pressure_payload::stall full;
+
+		try
+		{
+			parse_pressure(_cpu.read(), some, full);
+			pressure_payload::set_resource<pressure_payload::cpu_some_avg10>(buffer, some, full);
+
+			parse_pressure(_memory.read(), some, full);
+			pressure_payload::set_resource<pressure_payload::memory_some_avg10>(buffer, some, full);
+
+			parse_pressure(_io.read(), some, full);
+			pressure_payload::set_resource<pressure_payload::io_some_avg10>(buffer, some, full);
+		}
+		catch (const std::exception& ex)
+		{
+			// kernels without PSI (or booted with psi=0) don't provide or refuse to read these files,
+			// a failure may also be transient, so the files are tried again with a growing delay
+			if (_available)
+			{
+				std::cerr << "Pressure stall information is not available, sensor \"" << name() << "\" paused: "
+					<< ex.what() << "\n";
+				std::cerr.flush();
+			}
+
+			_available = false;
+
+			_cpu.close();
+			_memory.close();
+			_io.close();
+
+			_retry_time = std::chrono::steady_clock::now() + _backoff;
+			_backoff = std::min(_backoff * 2, std::chrono::seconds(60));
+
+			return 0;
+		}
+
+		if (!_available)
+		{
+			std::cerr << "Pressure stall information is available again, sensor \"" << name() << "\" resumed\n";
+			std::cerr.flush();
+		}
+
+		_available = true;
+		_backoff = std::chrono::seconds(1);
+
+		return pressure_payload::size();
+	}
+
+	sensor_schema pressure_sensor::schema() const
+	{
+		return payload_schema<pressure_payload>();
+	}
+
+	bool pressure_sensor::fixed_layout() const
+	{
+		return true;
+	}
+
+	sensor *create_sensor()
+	{
+		return new pressure_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
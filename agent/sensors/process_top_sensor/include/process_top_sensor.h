@@ -0,0 +1,109 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_PROCESS_TOP_SENSOR_H
+#define VIKKI_PROCESS_TOP_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+
+#include <dirent.h>
+#include <sys/types.h>
+
+#include <chrono>
+#include <unordered_map>
+
+namespace vikki
+{
+	class process_top_sensor
+		: public sensor
+	{
+	public:
+		process_top_sensor();
+		~process_top_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum
+		{
+			command_capacity = 16
+		};
+
+		struct process_state
+		{
+			uint64_t start_time;
+			uint64_t ticks;
+			std::chrono::steady_clock::time_point time;
+			double cpu;
+			uint64_t rss;
+			char command[command_capacity];
+			uint8_t command_size;
+			uint64_t generation;
+			uint64_t read_generation;
+			bool measured;
+		};
+
+		struct process_usage
+		{
+			pid_t pid;
+			const process_state *state;
+		};
+
+		DIR *_proc;
+		size_t _count;
+		size_t _scan_limit;
+		size_t _cursor;
+		long _ticks_per_second;
+		long _page_size;
+
+		std::unordered_map<pid_t, process_state> _states;
+		std::vector<pid_t> _pids;
+		std::vector<process_usage> _processes;
+		std::vector<process_usage> _top_cpu;
+		std::vector<process_usage> _top_memory;
+		std::vector<char> _buffer;
+		uint64_t _generation;
+		bool _top_ready;
+
+		void scan_processes();
+		bool read_process(pid_t pid, process_state& state, std::chrono::steady_clock::time_point time);
+		void select_top();
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_PROCESS_TOP_SENSOR_H
+
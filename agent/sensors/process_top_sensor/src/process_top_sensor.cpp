@@ -0,0 +1,411 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "process_top_sensor.h"
+#include "process_top_payload.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+namespace vikki
+{
+	process_top_sensor::process_top_sensor()
+		: _proc(nullptr), _count(10), _scan_limit(500), _cursor(0), _ticks_per_second(sysconf(_SC_CLK_TCK)),
+		  _page_size(sysconf(_SC_PAGESIZE)), _buffer(1024), _generation(0), _top_ready(false)
+	{
+	}
+
+	process_top_sensor::~process_top_sensor()
+	{
+		if (_proc != nullptr)
+		{
+			closedir(_proc);
+		}
+	}
+
+	std::string process_top_sensor::name() const
+	{
+		return "process_top";
+	}
+
+	size_t process_top_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (!_top_ready)
+		{
+			scan_processes();
+			select_top();
+
+			_top_ready = true;
+		}
+
+		// cpu usage needs two scans, so the first one only primes the per-process state
+		if (_generation < 2 || (_top_cpu.empty() && _top_memory.empty()))
+		{
+			_top_ready = false;
+
+			return 0;
+		}
+
+		size_t size = process_top_payload::header_size();
+
+		for (const process_usage& process : _top_cpu)
+		{
+			size += process_top_payload::entry_size(process.state->command_size);
+		}
+
+		for (const process_usage& process : _top_memory)
+		{
+			size += process_top_payload::entry_size(process.state->command_size);
+		}
+
+		if (capacity < size)
+		{
+			return size;
+		}
+
+		payload::writer out(buffer);
+
+		process_top_payload::write_header(out, static_cast<uint32_t>(_top_cpu.size()),
+			static_cast<uint32_t>(_top_memory.size()));
+
+		for (const std::vector<process_usage> *top : { &_top_cpu, &_top_memory })
+		{
+			for (const process_usage& process : *top)
+			{
+				const process_state& state = *process.state;
+				char *entry = process_top_payload::write_entry(out, state.command, state.command_size);
+
+				process_top_payload::encode(entry, static_cast<int64_t>(process.pid), state.cpu, state.rss);
+			}
+		}
+
+		_top_ready = false;
+
+		return out.size();
+	}
+
+	void process_top_sensor::init(const std::map<std::string, std::string>& params)
+	{
+		auto iter = params.find("count");
+		if (iter != params.end())
+		{
+			_count = std::stoul(iter->second);
+		}
+
+		iter = params.find("scan_limit");
+		if (iter != params.end())
+		{
+			_scan_limit = std::stoul(iter->second);
+		}
+
+		_proc = opendir("/proc");
+		if (_proc == nullptr)
+		{
+			throw exception("Can't open /proc directory, error code: " + std::to_string(errno));
+		}
+	}
+
+	void process_top_sensor::scan_processes()
+	{
+		const std::chrono::steady_clock::time_point time = std::chrono::steady_clock::now();
+
+		++_generation;
+
+		_pids.clear();
+
+		rewinddir(_proc);
+
+		while (dirent *entry = readdir(_proc))
+		{
+			const char *name = entry->d_name;
+
+			if (*name < '1' || *name > '9')
+			{
+				continue;
+			}
+
+			pid_t pid = 0;
+
+			while (*name >= '0' && *name <= '9')
+			{
+				pid = pid * 10 + (*name - '0');
+				++name;
+			}
+
+			if (*name != '\0')
+			{
+				continue;
+			}
+
+			_pids.push_back(pid);
+
+			process_state& state = _states[pid];
+			state.generation = _generation;
+
+			// new processes are read twice in a row so their cpu usage shows up without waiting for the window
+			if (!state.measured)
+			{
+				read_process(pid, state, time);
+			}
+		}
+
+		for (auto iter = _states.begin(); iter != _states.end(); )
+		{
+			if (iter->second.generation != _generation)
+			{
+				iter = _states.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+
+		// processes reported last time are refreshed on every scan, the rest in a rotating window
+		for (const std::vector<process_usage> *top : { &_top_cpu, &_top_memory })
+		{
+			for (const process_usage& process : *top)
+			{
+				auto iter = _states.find(process.pid);
+				if (iter != _states.end() && iter->second.read_generation != _generation)
+				{
+					read_process(process.pid, iter->second, time);
+				}
+			}
+		}
+
+		const size_t limit = _scan_limit == 0 ? _pids.size() : std::min(_scan_limit, _pids.size());
+
+		for (size_t i = 0; i < limit; ++i)
+		{
+			if (_cursor >= _pids.size())
+			{
+				_cursor = 0;
+			}
+
+			const pid_t pid = _pids[_cursor++];
+
+			auto iter = _states.find(pid);
+			if (iter != _states.end() && iter->second.read_generation != _generation)
+			{
+				read_process(pid, iter->second, time);
+			}
+		}
+	}
+
+	bool process_top_sensor::read_process(pid_t pid, process_state& state, std::chrono::steady_clock::time_point time)
+	{
+		char path[32];
+		const int path_size = snprintf(path, sizeof(path), "%d/stat", static_cast<int>(pid));
+
+		if (path_size <= 0 || static_cast<size_t>(path_size) >= sizeof(path))
+		{
+			return false;
+		}
+
+		// the process may exit between readdir and openat, which is not an error
+		int fd = openat(dirfd(_proc), path, O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+		{
+			return false;
+		}
+
+		ssize_t size = read(fd, _buffer.data(), _buffer.size() - 1);
+		close(fd);
+
+		if (size <= 0)
+		{
+			return false;
+		}
+
+		_buffer[size] = '\0';
+
+		// the command is enclosed in parentheses and may itself contain them
+		const char *command = static_cast<const char*>(std::memchr(_buffer.data(), '(', size));
+		const char *command_end = std::strrchr(_buffer.data(), ')');
+
+		if (command == nullptr || command_end == nullptr || command_end < command)
+		{
+			return false;
+		}
+
+		++command;
+
+		// stat carries the same resident page count as statm, so one read per process is enough;
+		// utime, stime, starttime and rss counted from the state field after the command
+		enum
+		{
+			utime_field = 11,
+			stime_field = 12,
+			start_time_field = 19,
+			rss_field = 21
+		};
+
+		uint64_t utime = 0;
+		uint64_t stime = 0;
+		uint64_t start_time = 0;
+		uint64_t rss = 0;
+
+		const char *p = command_end + 1;
+		const char *end = _buffer.data() + size;
+
+		for (int field = 0; field <= rss_field && p < end; ++field)
+		{
+			while (p < end && *p == ' ')
+			{
+				++p;
+			}
+
+			uint64_t *value = nullptr;
+
+			switch (field)
+			{
+			case utime_field:
+				value = &utime;
+				break;
+
+			case stime_field:
+				value = &stime;
+				break;
+
+			case start_time_field:
+				value = &start_time;
+				break;
+
+			case rss_field:
+				value = &rss;
+				break;
+			}
+
+			if (value != nullptr)
+			{
+				while (p < end && *p >= '0' && *p <= '9')
+				{
+					*value = *value * 10 + (*p - '0');
+					++p;
+				}
+			}
+
+			while (p < end && *p != ' ')
+			{
+				++p;
+			}
+		}
+
+		const uint64_t ticks = utime + stime;
+
+		// a different start time means the pid was reused by a new process
+		if (state.read_generation == 0 || state.start_time != start_time)
+		{
+			state.cpu = 0.0;
+			state.measured = false;
+		}
+		else
+		{
+			state.measured = true;
+
+			const double elapsed = std::chrono::duration<double>(time - state.time).count();
+
+			if (elapsed > 0.0 && ticks >= state.ticks)
+			{
+				state.cpu = (ticks - state.ticks) * 100.0 / (elapsed * _ticks_per_second);
+			}
+		}
+
+		state.start_time = start_time;
+		state.ticks = ticks;
+		state.time = time;
+		state.rss = rss * _page_size;
+		state.command_size = static_cast<uint8_t>(std::min<size_t>(command_end - command, command_capacity));
+		std::memcpy(state.command, command, state.command_size);
+		state.read_generation = _generation;
+
+		return true;
+	}
+
+	void process_top_sensor::select_top()
+	{
+		_processes.clear();
+
+		for (const std::pair<const pid_t, process_state>& item : _states)
+		{
+			if (item.second.read_generation != 0)
+			{
+				process_usage process;
+
+				process.pid = item.first;
+				process.state = &item.second;
+
+				_processes.push_back(process);
+			}
+		}
+
+		// only processes read by this scan compete for cpu, the rest hold usage from earlier windows
+		const uint64_t generation = _generation;
+
+		auto fresh_end = std::partition(_processes.begin(), _processes.end(),
+			[generation](const process_usage& process)
+			{
+				return process.state->read_generation == generation;
+			});
+
+		size_t count = std::min<size_t>(_count, fresh_end - _processes.begin());
+
+		std::partial_sort(_processes.begin(), _processes.begin() + count, fresh_end,
+			[](const process_usage& left, const process_usage& right)
+			{
+				return left.state->cpu > right.state->cpu;
+			});
+
+		_top_cpu.assign(_processes.begin(), _processes.begin() + count);
+
+		// resident size changes slowly, so memory is ranked over every process read so far
+		count = std::min(_count, _processes.size());
+
+		std::partial_sort(_processes.begin(), _processes.begin() + count, _processes.end(),
+			[](const process_usage& left, const process_usage& right)
+			{
+				return left.state->rss > right.state->rss;
+			});
+
+		_top_memory.assign(_processes.begin(), _processes.begin() + count);
+	}
+
+	sensor *create_sensor()
+	{
+		return new process_top_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
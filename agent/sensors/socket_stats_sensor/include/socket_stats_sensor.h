@@ -0,0 +1,78 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_SOCKET_STATS_SENSOR_H
+#define VIKKI_SOCKET_STATS_SENSOR_H
+
+#include "exception.h"
+#include "sensor.h"
+#include "procfs_reader.h"
+
+namespace vikki
+{
+	class socket_stats_sensor
+		: public sensor
+	{
+	public:
+		socket_stats_sensor();
+		~socket_stats_sensor() override;
+
+		std::string name() const override;
+		size_t sample(char *buffer, size_t capacity) override;
+		sensor_schema schema() const override;
+		void init(const std::map<std::string, std::string>& params) override;
+
+	private:
+		enum
+		{
+			state_count = 13
+		};
+
+		int _netlink;
+		uint32_t _sequence;
+		std::vector<char> _buffer;
+
+		procfs_reader _sockstat;
+		procfs_reader _snmp;
+		procfs_reader _netstat;
+
+		void dump(uint8_t family, uint64_t *states, uint64_t& listen_queue_max);
+
+		static uint64_t parse_time_wait(const char *sockstat);
+		static void parse_snmp(const char *data, const char *section, const char *const *keys, size_t count,
+			uint64_t *values);
+
+	};
+
+	extern "C"
+	{
+		sensor* create_sensor();
+		void destroy_sensor(sensor *handle);
+	}
+}
+
+#endif // VIKKI_SOCKET_STATS_SENSOR_H
+
@@ -0,0 +1,303 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "socket_stats_sensor.h"
+#include "socket_stats_payload.h"
+
+#include <linux/inet_diag.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace vikki
+{
+	namespace
+	{
+		// pending connection requests are reported in a state the libc headers don't name
+		const uint8_t tcp_new_syn_recv = 12;
+	}
+
+	socket_stats_sensor::socket_stats_sensor()
+		: _netlink(-1), _sequence(0), _buffer(65536),
+		  _sockstat("/proc/net/sockstat", 1024), _snmp("/proc/net/snmp"), _netstat("/proc/net/netstat")
+	{
+	}
+
+	socket_stats_sensor::~socket_stats_sensor()
+	{
+		if (_netlink != -1)
+		{
+			close(_netlink);
+		}
+	}
+
+	std::string socket_stats_sensor::name() const
+	{
+		return "socket_stats";
+	}
+
+	size_t socket_stats_sensor::sample(char *buffer, size_t capacity)
+	{
+		if (capacity < socket_stats_payload::size())
+		{
+			return socket_stats_payload::size();
+		}
+
+		uint64_t states[state_count] = { 0 };
+		uint64_t listen_queue_max = 0;
+
+		dump(AF_INET, states, listen_queue_max);
+		dump(AF_INET6, states, listen_queue_max);
+
+		// TIME_WAIT sockets usually outnumber the rest, the kernel keeps their count for free
+		states[TCP_TIME_WAIT] = parse_time_wait(_sockstat.read());
+
+		static const char *const snmp_keys[] = { "RetransSegs", "OutSegs", "CurrEstab" };
+		uint64_t snmp[3] = { 0 };
+
+		parse_snmp(_snmp.read(), "Tcp:", snmp_keys, 3, snmp);
+
+		// ESTABLISHED sockets aren't dumped either, the kernel counts them together with CLOSE_WAIT ones
+		states[TCP_ESTABLISHED] = snmp[2] > states[TCP_CLOSE_WAIT] ? snmp[2] - states[TCP_CLOSE_WAIT] : 0;
+
+		static const char *const netstat_keys[] = { "ListenOverflows", "ListenDrops" };
+		uint64_t netstat[2] = { 0 };
+
+		parse_snmp(_netstat.read(), "TcpExt:", netstat_keys, 2, netstat);
+
+		socket_stats_payload::encode(buffer, states[TCP_ESTABLISHED], states[TCP_SYN_SENT],
+			states[TCP_SYN_RECV] + states[tcp_new_syn_recv], states[TCP_FIN_WAIT1], states[TCP_FIN_WAIT2],
+			states[TCP_TIME_WAIT], states[TCP_CLOSE], states[TCP_CLOSE_WAIT], states[TCP_LAST_ACK], states[TCP_LISTEN],
+			states[TCP_CLOSING], listen_queue_max, netstat[0], netstat[1], snmp[0], snmp[1]);
+
+		return socket_stats_payload::size();
+	}
+
+	sensor_schema socket_stats_sensor::schema() const
+	{
+		return payload_schema<socket_stats_payload>();
+	}
+
+	void socket_stats_sensor::init(const std::map<std::string, std::string>&)
+	{
+		_netlink = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG);
+		if (_netlink == -1)
+		{
+			throw exception("Can't open sock_diag netlink socket, error code: " + std::to_string(errno));
+		}
+	}
+
+	void socket_stats_sensor::dump(uint8_t family, uint64_t *states, uint64_t& listen_queue_max)
+	{
+		struct
+		{
+			nlmsghdr header;
+			inet_diag_req_v2 request;
+		} message;
+
+		std::memset(&message, 0, sizeof(message));
+
+		message.header.nlmsg_len = sizeof(message);
+		message.header.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+		message.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+		message.header.nlmsg_seq = ++_sequence;
+
+		// the numerous ESTABLISHED and TIME_WAIT states are counted from procfs, the rest are dumped
+		// without extensions, so each socket costs the kernel one bare inet_diag_msg
+		message.request.sdiag_family = family;
+		message.request.sdiag_protocol = IPPROTO_TCP;
+		message.request.idiag_states = ((1u << state_count) - 1) & ~(1u << TCP_TIME_WAIT) & ~(1u << TCP_ESTABLISHED);
+		message.request.idiag_ext = 0;
+
+		sockaddr_nl address;
+		std::memset(&address, 0, sizeof(address));
+		address.nl_family = AF_NETLINK;
+
+		if (sendto(_netlink, &message, sizeof(message), 0, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+		{
+			throw exception("Can't send sock_diag request, error code: " + std::to_string(errno));
+		}
+
+		while (true)
+		{
+			ssize_t len = recv(_netlink, _buffer.data(), _buffer.size(), 0);
+
+			if (len < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+
+				throw exception("Can't receive sock_diag reply, error code: " + std::to_string(errno));
+			}
+
+			const nlmsghdr *header = reinterpret_cast<const nlmsghdr*>(_buffer.data());
+			int size = static_cast<int>(len);
+
+			for (; NLMSG_OK(header, size); header = NLMSG_NEXT(header, size))
+			{
+				if (header->nlmsg_seq != _sequence)
+				{
+					continue;
+				}
+
+				if (header->nlmsg_type == NLMSG_DONE)
+				{
+					return;
+				}
+
+				if (header->nlmsg_type == NLMSG_ERROR)
+				{
+					const nlmsgerr *error = static_cast<const nlmsgerr*>(NLMSG_DATA(header));
+
+					// a kernel built without IPv6 has nothing to dump for it
+					if (error->error == -ENOENT)
+					{
+						return;
+					}
+
+					throw exception("Can't dump sockets, error code: " + std::to_string(-error->error));
+				}
+
+				const inet_diag_msg *socket = static_cast<const inet_diag_msg*>(NLMSG_DATA(header));
+
+				if (socket->idiag_state < state_count)
+				{
+					++states[socket->idiag_state];
+				}
+
+				// for listeners the receive queue is the accept backlog in use
+				if (socket->idiag_state == TCP_LISTEN)
+				{
+					listen_queue_max = std::max<uint64_t>(listen_queue_max, socket->idiag_rqueue);
+				}
+			}
+		}
+	}
+
+	uint64_t socket_stats_sensor::parse_time_wait(const char *sockstat)
+	{
+		const char *tcp = std::strstr(sockstat, "TCP:");
+		if (tcp == nullptr)
+		{
+			return 0;
+		}
+
+		const char *eol = std::strchr(tcp, '\n');
+		const char *tw = std::strstr(tcp, " tw ");
+
+		if (tw == nullptr || (eol != nullptr && tw > eol))
+		{
+			return 0;
+		}
+
+		return std::strtoull(tw + 4, nullptr, 10);
+	}
+
+	void socket_stats_sensor::parse_snmp(const char *data, const char *section, const char *const *keys, size_t count,
+		uint64_t *values)
+	{
+		// each section is a line of names followed by a line of values, both prefixed with the section name
+		const size_t section_size = std::strlen(section);
+
+		const char *names = data;
+
+		while (names != nullptr && std::strncmp(names, section, section_size) != 0)
+		{
+			names = std::strchr(names, '\n');
+			names = names != nullptr ? names + 1 : nullptr;
+		}
+
+		if (names == nullptr)
+		{
+			return;
+		}
+
+		const char *numbers = std::strchr(names, '\n');
+		if (numbers == nullptr || std::strncmp(numbers + 1, section, section_size) != 0)
+		{
+			return;
+		}
+
+		const char *name = names + section_size;
+		const char *number = numbers + 1 + section_size;
+
+		while (*name == ' ' && *number == ' ')
+		{
+			while (*name == ' ')
+			{
+				++name;
+			}
+
+			while (*number == ' ')
+			{
+				++number;
+			}
+
+			const char *name_end = name;
+
+			while (*name_end != ' ' && *name_end != '\n' && *name_end != '\0')
+			{
+				++name_end;
+			}
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				if (std::strlen(keys[i]) == static_cast<size_t>(name_end - name) &&
+					std::strncmp(keys[i], name, name_end - name) == 0)
+				{
+					values[i] = std::strtoull(number, nullptr, 10);
+				}
+			}
+
+			name = name_end;
+
+			while (*number != ' ' && *number != '\n' && *number != '\0')
+			{
+				++number;
+			}
+		}
+	}
+
+	sensor *create_sensor()
+	{
+		return new socket_stats_sensor();
+	}
+
+	void destroy_sensor(sensor *handle)
+	{
+		delete handle;
+	}
+}
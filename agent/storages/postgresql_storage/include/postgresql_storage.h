@@ -46,10 +46,16 @@ namespace vikki
 		void open(const std::map<std::string, std::string>& params) override;
 		void close() override;
 
-		void put_data(const std::string& sensor_name, std::time_t time, const std::vector<char>& data) override;
-		sensor_data_t get_data(const std::string& sensor_name, std::time_t from, std::time_t to) override;
+		void put_data(const std::string& sensor_name, timestamp time, const std::vector<char>& data) override;
+		sensor_data_t get_data(const std::string& sensor_name, timestamp from, timestamp to) override;
+
+		void put_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t time, const aggregate& data) override;
+		rollup_data_t get_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t from, std::time_t to) override;
+
+		void purge_data(const std::string& sensor_name, std::time_t resolution, std::time_t before) override;
 
 		void prepare_entity(const std::string& sensor_name) override;
+		void prepare_rollup_entity(const std::string& sensor_name, std::time_t resolution) override;
 
 	private:
 		std::map<std::string, std::string> _conn_params;
@@ -60,6 +66,9 @@ namespace vikki
 
 		bool is_entity_exists(const std::string& name);
 		void create_entity(const std::string& name);
+		void create_rollup_entity(const std::string& name);
+
+		static std::string rollup_entity_name(const std::string& sensor_name, std::time_t resolution);
 
 		static uint64_t htonll(uint64_t value);
 
@@ -75,10 +75,10 @@ namespace vikki
 		_conn = nullptr;
 	}
 
-	void postgresql_storage::put_data(const std::string& sensor_name, std::time_t time, const std::vector<char>& data)
+	void postgresql_storage::put_data(const std::string& sensor_name, timestamp time, const std::vector<char>& data)
 	{
 		std::string query = "INSERT INTO " + _schema + "." + sensor_name + " ( ";
-		query += "created, data ) VALUES ( to_timestamp($1), $2::bytea )";
+		query += "created, data ) VALUES ( to_timestamp(0) + $1::bigint * interval '1 microsecond', $2::bytea )";
 
 		std::string time_str = std::to_string(time);
 
@@ -108,13 +108,14 @@ namespace vikki
 		PQclear(result);
 	}
 
-	storage::sensor_data_t postgresql_storage::get_data(const std::string& sensor_name, std::time_t from, std::time_t to)
+	storage::sensor_data_t postgresql_storage::get_data(const std::string& sensor_name, timestamp from, timestamp to)
 	{
 		PGconn *conn = create_connection();
 
-		std::string query = "SELECT extract(epoch FROM t.created)::bigint AS time, t.data ";
+		std::string query = "SELECT ( extract(epoch FROM t.created) * 1000000 )::bigint AS time, t.data ";
 		query += "FROM " + _schema + "." + sensor_name + " t ";
-		query += "WHERE t.created BETWEEN to_timestamp($1) AND to_timestamp($2) ";
+		query += "WHERE t.created BETWEEN to_timestamp(0) + $1::bigint * interval '1 microsecond' AND ";
+		query += "	to_timestamp(0) + $2::bigint * interval '1 microsecond' ";
 		query += "ORDER BY t.created ASC;";
 
 		std::string from_str = std::to_string(from);
@@ -148,7 +149,7 @@ namespace vikki
 
 		for (int i = 0; i < PQntuples(result); ++i)
 		{
-			std::time_t time = htonll(*reinterpret_cast<uint64_t*>(PQgetvalue(result, i, 0)));
+			timestamp time = htonll(*reinterpret_cast<uint64_t*>(PQgetvalue(result, i, 0)));
 
 			data[time] = std::vector<char>(PQgetlength(result, i, 1));
 
@@ -161,6 +162,139 @@ namespace vikki
 		return data;
 	}
 
+	void postgresql_storage::put_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t time, const aggregate& data)
+	{
+		const std::string entity_name = rollup_entity_name(sensor_name, resolution);
+
+		std::string query = "INSERT INTO " + _schema + "." + entity_name + " ( ";
+		query += "created, count, min, max, avg ) VALUES ( to_timestamp($1), $2::bigint, $3::bytea, $4::bytea, $5::bytea )";
+
+		std::string time_str = std::to_string(time);
+		std::string count_str = std::to_string(data.count);
+
+		const char *values[5];
+		int lengths[5];
+		int formats[5];
+
+		values[0] = time_str.c_str();
+		lengths[0] = 0;
+		formats[0] = 0;
+
+		values[1] = count_str.c_str();
+		lengths[1] = 0;
+		formats[1] = 0;
+
+		values[2] = data.min.data();
+		lengths[2] = data.min.size();
+		formats[2] = 1;
+
+		values[3] = data.max.data();
+		lengths[3] = data.max.size();
+		formats[3] = 1;
+
+		values[4] = data.avg.data();
+		lengths[4] = data.avg.size();
+		formats[4] = 1;
+
+		PGresult *result = PQexecParams(_conn, query.c_str(), 5, NULL, values, lengths, formats, 1);
+		if (PQresultStatus(result) != PGRES_COMMAND_OK)
+		{
+			std::string error = "Can't put rollup data of sensor " + sensor_name + ": ";
+			error += PQerrorMessage(_conn);
+
+			PQclear(result);
+
+			throw exception(error);
+		}
+
+		PQclear(result);
+	}
+
+	storage::rollup_data_t postgresql_storage::get_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t from, std::time_t to)
+	{
+		PGconn *conn = create_connection();
+
+		std::string query = "SELECT extract(epoch FROM t.created)::bigint AS time, t.count, t.min, t.max, t.avg ";
+		query += "FROM " + _schema + "." + rollup_entity_name(sensor_name, resolution) + " t ";
+		query += "WHERE t.created BETWEEN to_timestamp($1) AND to_timestamp($2) ";
+		query += "ORDER BY t.created ASC;";
+
+		std::string from_str = std::to_string(from);
+		std::string to_str = std::to_string(to);
+
+		const char *values[2];
+		int lengths[2];
+		int formats[2];
+
+		values[0] = from_str.c_str();
+		lengths[0] = 0;
+		formats[0] = 0;
+
+		values[1] = to_str.c_str();
+		lengths[1] = 0;
+		formats[1] = 0;
+
+		PGresult *result = PQexecParams(conn, query.c_str(), 2, NULL, values, lengths, formats, 1);
+		if (PQresultStatus(result) != PGRES_TUPLES_OK)
+		{
+			std::string error = "Can't get rollup data of sensor " + sensor_name + ": ";
+			error += PQerrorMessage(conn);
+
+			PQclear(result);
+			PQfinish(conn);
+
+			throw exception(error);
+		}
+
+		rollup_data_t data;
+
+		for (int i = 0; i < PQntuples(result); ++i)
+		{
+			std::time_t time = htonll(*reinterpret_cast<uint64_t*>(PQgetvalue(result, i, 0)));
+
+			aggregate value;
+
+			value.count = htonll(*reinterpret_cast<uint64_t*>(PQgetvalue(result, i, 1)));
+			value.min = std::vector<char>(PQgetvalue(result, i, 2), PQgetvalue(result, i, 2) + PQgetlength(result, i, 2));
+			value.max = std::vector<char>(PQgetvalue(result, i, 3), PQgetvalue(result, i, 3) + PQgetlength(result, i, 3));
+			value.avg = std::vector<char>(PQgetvalue(result, i, 4), PQgetvalue(result, i, 4) + PQgetlength(result, i, 4));
+
+			data.insert(std::make_pair(time, value));
+		}
+
+		PQclear(result);
+		PQfinish(conn);
+
+		return data;
+	}
+
+	void postgresql_storage::purge_data(const std::string& sensor_name, std::time_t resolution, std::time_t before)
+	{
+		const std::string entity_name = resolution > 0 ? rollup_entity_name(sensor_name, resolution) : sensor_name;
+
+		std::string query = "DELETE FROM " + _schema + "." + entity_name + " ";
+		query += "WHERE created < to_timestamp($1);";
+
+		std::string before_str = std::to_string(before);
+
+		const char *values[1];
+
+		values[0] = before_str.c_str();
+
+		PGresult *result = PQexecParams(_conn, query.c_str(), 1, NULL, values, NULL, NULL, 0);
+		if (PQresultStatus(result) != PGRES_COMMAND_OK)
+		{
+			std::string error = "Can't purge data of sensor " + sensor_name + ": ";
+			error += PQerrorMessage(_conn);
+
+			PQclear(result);
+
+			throw exception(error);
+		}
+
+		PQclear(result);
+	}
+
 	void postgresql_storage::prepare_entity(const std::string& sensor_name)
 	{
 		if (_conn == nullptr || PQstatus(_conn) != CONNECTION_OK)
@@ -174,6 +308,21 @@ namespace vikki
 		}
 	}
 
+	void postgresql_storage::prepare_rollup_entity(const std::string& sensor_name, std::time_t resolution)
+	{
+		if (_conn == nullptr || PQstatus(_conn) != CONNECTION_OK)
+		{
+			throw exception("Can't prepare rollup entity for sensor " + sensor_name + ": connection closed");
+		}
+
+		const std::string entity_name = rollup_entity_name(sensor_name, resolution);
+
+		if (!is_entity_exists(entity_name))
+		{
+			create_rollup_entity(entity_name);
+		}
+	}
+
 	PGconn* postgresql_storage::create_connection() const
 	{
 		std::string conn_info;
@@ -253,6 +402,36 @@ namespace vikki
 		PQclear(result);
 	}
 
+	void postgresql_storage::create_rollup_entity(const std::string& name)
+	{
+		std::string query = "CREATE TABLE " + _schema + "." + name;
+		query += " ( id serial NOT NULL, ";
+		query += "created timestamptz NOT NULL, ";
+		query += "count bigint NOT NULL, ";
+		query += "min bytea NOT NULL, ";
+		query += "max bytea NOT NULL, ";
+		query += "avg bytea NOT NULL ); ";
+		query += "CREATE INDEX ON " + _schema + "." + name + " ( created );";
+
+		PGresult *result = PQexec(_conn, query.c_str());
+		if (PQresultStatus(result) != PGRES_COMMAND_OK)
+		{
+			std::string error = "Can't create entity " + name + ": ";
+			error += PQerrorMessage(_conn);
+
+			PQclear(result);
+
+			throw exception(error);
+		}
+
+		PQclear(result);
+	}
+
+	std::string postgresql_storage::rollup_entity_name(const std::string& sensor_name, std::time_t resolution)
+	{
+		return sensor_name + "_rollup_" + std::to_string(resolution);
+	}
+
 	uint64_t postgresql_storage::htonll(uint64_t value)
 	{
 		static const int num = 42;
@@ -0,0 +1,93 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_AGENT_TEST_H
+#define VIKKI_AGENT_TEST_H
+
+#include <cmath>
+#include <iostream>
+
+#define VIKKI_CHECK(expr) \
+	vikki::test::check(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+
+#define VIKKI_CHECK_EQUAL(actual, expected) \
+	vikki::test::check_equal((actual), (expected), #actual, __FILE__, __LINE__)
+
+#define VIKKI_CHECK_NEAR(actual, expected, tolerance) \
+	vikki::test::check(std::fabs(static_cast<double>(actual) - static_cast<double>(expected)) <= (tolerance), \
+		#actual " near " #expected, __FILE__, __LINE__)
+
+#define VIKKI_CHECK_THROWS(expr) \
+	do \
+	{ \
+		bool thrown = false; \
+		try { expr; } catch (const std::exception&) { thrown = true; } \
+		vikki::test::check(thrown, #expr " throws", __FILE__, __LINE__); \
+	} \
+	while (false)
+
+namespace vikki
+{
+	namespace test
+	{
+		inline int& failures()
+		{
+			static int count = 0;
+
+			return count;
+		}
+
+		inline void check(bool passed, const char *expr, const char *file, int line)
+		{
+			if (!passed)
+			{
+				std::cerr << file << ":" << line << ": check failed: " << expr << "\n";
+
+				++failures();
+			}
+		}
+
+		template<typename T, typename U>
+		void check_equal(const T& actual, const U& expected, const char *expr, const char *file, int line)
+		{
+			if (!(actual == expected))
+			{
+				std::cerr << file << ":" << line << ": check failed: " << expr << " is " << actual << ", expected "
+					<< expected << "\n";
+
+				++failures();
+			}
+		}
+
+		// the exit code of a test executable
+		inline int result()
+		{
+			return failures() == 0 ? 0 : 1;
+		}
+	}
+}
+
+#endif // VIKKI_AGENT_TEST_H
@@ -0,0 +1,152 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "aggregate.h"
+#include "test.h"
+
+#include <cstring>
+
+namespace
+{
+	using namespace vikki;
+
+	const std::vector<value_type> layout { value_type::int64, value_type::uint64, value_type::float64 };
+
+	std::vector<char> pack(int64_t a, uint64_t b, double c)
+	{
+		std::vector<char> data(24);
+
+		std::memcpy(data.data(), &a, 8);
+		std::memcpy(data.data() + 8, &b, 8);
+		std::memcpy(data.data() + 16, &c, 8);
+
+		return data;
+	}
+
+	template<typename T>
+	T unpack(const std::vector<char>& data, size_t offset)
+	{
+		T value;
+		std::memcpy(&value, data.data() + offset, sizeof(T));
+
+		return value;
+	}
+
+	void test_bucket_start()
+	{
+		VIKKI_CHECK_EQUAL(bucket_start(125, 60), 120);
+		VIKKI_CHECK_EQUAL(bucket_start(120, 60), 120);
+		VIKKI_CHECK_EQUAL(bucket_start(119, 60), 60);
+		VIKKI_CHECK_EQUAL(bucket_start(7, 1), 7);
+		VIKKI_CHECK_EQUAL(bucket_start(7, 0), 7);
+
+		// times before the epoch still round down, not towards zero
+		VIKKI_CHECK_EQUAL(bucket_start(-1, 60), -60);
+		VIKKI_CHECK_EQUAL(bucket_start(-60, 60), -60);
+	}
+
+	void test_samples()
+	{
+		aggregator data(layout);
+
+		VIKKI_CHECK(data.empty());
+
+		data.add(pack(-5, 10, 1.5));
+		data.add(pack(3, 30, -0.5));
+		data.add(pack(8, 20, 2.0));
+
+		// short payloads are ignored
+		data.add(std::vector<char>(8));
+
+		const aggregate value = data.result();
+
+		VIKKI_CHECK_EQUAL(value.count, 3u);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.min, 0), -5);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.max, 0), 8);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.avg, 0), 2);
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(value.min, 8), 10u);
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(value.max, 8), 30u);
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(value.avg, 8), 20u);
+		VIKKI_CHECK_EQUAL(unpack<double>(value.min, 16), -0.5);
+		VIKKI_CHECK_EQUAL(unpack<double>(value.max, 16), 2.0);
+		VIKKI_CHECK_NEAR(unpack<double>(value.avg, 16), 1.0, 1e-12);
+	}
+
+	void test_merge()
+	{
+		aggregator first(layout);
+		first.add(pack(1, 1, 1.0));
+
+		aggregator second(layout);
+		second.add(pack(4, 4, 4.0));
+		second.add(pack(7, 7, 7.0));
+		second.add(pack(10, 10, 10.0));
+
+		aggregator merged(layout);
+		merged.add(first.result());
+		merged.add(second.result());
+
+		// an empty aggregate carries no samples and must not reset min or max
+		merged.add(aggregator(layout).result());
+
+		const aggregate value = merged.result();
+
+		// averages are weighted by sample count, not by the number of merged aggregates
+		VIKKI_CHECK_EQUAL(value.count, 4u);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.min, 0), 1);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.max, 0), 10);
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(value.avg, 8), 6u);
+		VIKKI_CHECK_NEAR(unpack<double>(value.avg, 16), 5.5, 1e-12);
+	}
+
+	void test_reset()
+	{
+		aggregator data(layout);
+
+		data.add(pack(100, 100, 100.0));
+		data.reset();
+
+		VIKKI_CHECK(data.empty());
+
+		data.add(pack(-3, 2, 0.25));
+
+		const aggregate value = data.result();
+
+		VIKKI_CHECK_EQUAL(value.count, 1u);
+		VIKKI_CHECK_EQUAL(unpack<int64_t>(value.max, 0), -3);
+		VIKKI_CHECK_EQUAL(unpack<double>(value.avg, 16), 0.25);
+	}
+}
+
+int main()
+{
+	test_bucket_start();
+	test_samples();
+	test_merge();
+	test_reset();
+
+	return vikki::test::result();
+}
@@ -0,0 +1,210 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "counter_rate.h"
+#include "test.h"
+
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+	using namespace vikki;
+
+	const sensor_schema schema {
+		sensor_field { "level", value_type::uint64, field_kind::gauge },
+		sensor_field { "bytes", value_type::uint64, field_kind::counter },
+		sensor_field { "packets", value_type::uint64, field_kind::counter32 },
+		sensor_field { "balance", value_type::int64, field_kind::counter }
+	};
+
+	std::vector<char> pack(uint64_t level, uint64_t bytes, uint64_t packets, int64_t balance)
+	{
+		std::vector<char> data(32);
+
+		std::memcpy(data.data(), &level, 8);
+		std::memcpy(data.data() + 8, &bytes, 8);
+		std::memcpy(data.data() + 16, &packets, 8);
+		std::memcpy(data.data() + 24, &balance, 8);
+
+		return data;
+	}
+
+	template<typename T>
+	T unpack(const std::vector<char>& data, size_t offset)
+	{
+		T value;
+		std::memcpy(&value, data.data() + offset, sizeof(T));
+
+		return value;
+	}
+
+	// the sensor times its own interval, so the test brackets it between one measured strictly inside and one
+	// measured around the two apply calls, and every rate must lie between the delta over each of them
+	struct timing
+	{
+		std::chrono::steady_clock::time_point before;
+		std::chrono::steady_clock::time_point after;
+		double inner;
+		double outer;
+	};
+
+	bool apply(counter_rate& rates, std::vector<char>& data, timing& time)
+	{
+		const std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+		const bool result = rates.apply(data);
+		const std::chrono::steady_clock::time_point after = std::chrono::steady_clock::now();
+
+		time.inner = std::chrono::duration<double>(before - time.after).count();
+		time.outer = std::chrono::duration<double>(after - time.before).count();
+		time.before = before;
+		time.after = after;
+
+		return result;
+	}
+
+	bool rate_matches(const std::vector<char>& data, size_t offset, double delta, const timing& time)
+	{
+		const double rate = unpack<double>(data, offset);
+
+		return rate * time.inner <= delta * (1.0 + 1e-9) && rate * time.outer >= delta * (1.0 - 1e-9);
+	}
+
+	void pause()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	void test_schema()
+	{
+		counter_rate rates(schema);
+
+		VIKKI_CHECK(!rates.empty());
+
+		const sensor_schema result = rates.schema();
+
+		// counters become float64 gauges, gauges pass through
+		VIKKI_CHECK(result[0].type == value_type::uint64);
+		VIKKI_CHECK(result[0].kind == field_kind::gauge);
+
+		for (size_t i = 1; i < result.size(); ++i)
+		{
+			VIKKI_CHECK(result[i].type == value_type::float64);
+			VIKKI_CHECK(result[i].kind == field_kind::gauge);
+		}
+
+		counter_rate gauges(sensor_schema { schema[0] });
+
+		VIKKI_CHECK(gauges.empty());
+	}
+
+	void test_rates()
+	{
+		counter_rate rates(schema);
+		timing time = timing();
+
+		std::vector<char> data = pack(5, 1000, 100, -10);
+
+		// the first sample only primes the counters
+		VIKKI_CHECK(!apply(rates, data, time));
+
+		pause();
+
+		data = pack(6, 3000, 400, 20);
+
+		VIKKI_CHECK(apply(rates, data, time));
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(data, 0), 6u);
+		VIKKI_CHECK(rate_matches(data, 8, 2000.0, time));
+		VIKKI_CHECK(rate_matches(data, 16, 300.0, time));
+		VIKKI_CHECK(rate_matches(data, 24, 30.0, time));
+
+		pause();
+
+		data = pack(7, 3000, 4294967200ull, 20);
+
+		VIKKI_CHECK(apply(rates, data, time));
+
+		pause();
+
+		// a counter declared 32-bit wraps at 2^32
+		data = pack(8, 3500, 100, 20);
+
+		VIKKI_CHECK(apply(rates, data, time));
+		VIKKI_CHECK(rate_matches(data, 8, 500.0, time));
+		VIKKI_CHECK(rate_matches(data, 16, 196.0, time));
+		VIKKI_CHECK_EQUAL(unpack<double>(data, 24), 0.0);
+	}
+
+	void test_reset()
+	{
+		counter_rate rates(schema);
+		timing time = timing();
+
+		std::vector<char> data = pack(0, 5000000000ull, 0, 0);
+		apply(rates, data, time);
+
+		pause();
+
+		// a 64-bit counter that drops below 2^32 restarted, it did not wrap, so no rate is invented
+		data = pack(0, 100, 0, 0);
+
+		VIKKI_CHECK(!apply(rates, data, time));
+
+		pause();
+
+		// the reset value is the new base
+		data = pack(0, 600, 0, 0);
+
+		VIKKI_CHECK(apply(rates, data, time));
+		VIKKI_CHECK(rate_matches(data, 8, 500.0, time));
+
+		pause();
+
+		data = pack(0, 700, 0, -5);
+
+		VIKKI_CHECK(!apply(rates, data, time));
+	}
+
+	void test_size_mismatch()
+	{
+		counter_rate rates(schema);
+
+		std::vector<char> data(8);
+
+		VIKKI_CHECK_THROWS(rates.apply(data));
+	}
+}
+
+int main()
+{
+	test_schema();
+	test_rates();
+	test_reset();
+	test_size_mismatch();
+
+	return vikki::test::result();
+}
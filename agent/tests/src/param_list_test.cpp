@@ -0,0 +1,81 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "param_list.h"
+#include "test.h"
+
+namespace
+{
+	using namespace vikki;
+
+	void test_split()
+	{
+		const std::vector<std::string> items = split_param_list(" eth0 ,\twlan*, ,lo,");
+
+		VIKKI_CHECK_EQUAL(items.size(), 3u);
+		VIKKI_CHECK_EQUAL(items[0], "eth0");
+		VIKKI_CHECK_EQUAL(items[1], "wlan*");
+		VIKKI_CHECK_EQUAL(items[2], "lo");
+
+		VIKKI_CHECK(split_param_list("").empty());
+		VIKKI_CHECK(split_param_list(" , ").empty());
+	}
+
+	void test_filter()
+	{
+		name_filter everything;
+
+		VIKKI_CHECK(everything.accepted("sda"));
+
+		// defaults apply until the params replace them
+		name_filter defaults({ "loop*" });
+
+		VIKKI_CHECK(!defaults.accepted("loop0"));
+		VIKKI_CHECK(defaults.accepted("sda"));
+
+		defaults.init({ { "exclude", "sdb" } });
+
+		VIKKI_CHECK(defaults.accepted("loop0"));
+		VIKKI_CHECK(!defaults.accepted("sdb"));
+
+		// exclusion wins over inclusion
+		name_filter filter;
+		filter.init({ { "include", "eth*, en*" }, { "exclude", "eth1" } });
+
+		VIKKI_CHECK(filter.accepted("eth0"));
+		VIKKI_CHECK(filter.accepted("enp3s0"));
+		VIKKI_CHECK(!filter.accepted("eth1"));
+		VIKKI_CHECK(!filter.accepted("lo"));
+	}
+}
+
+int main()
+{
+	test_split();
+	test_filter();
+
+	return vikki::test::result();
+}
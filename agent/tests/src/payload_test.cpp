@@ -0,0 +1,197 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "payload.h"
+#include "schema.h"
+#include "test.h"
+
+#include <cstring>
+
+namespace
+{
+	using namespace vikki;
+
+	struct sample_payload
+		: payload::layout<
+			payload::gauge<int64_t>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::counter32<uint64_t>>
+	{
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = { "delta", "total", "ratio", "packets" };
+
+			return names[index];
+		}
+	};
+
+	static_assert(sample_payload::size() == 32, "sample payload size");
+	static_assert(sample_payload::offset<2>() == 16, "sample payload offset");
+
+	void test_layout()
+	{
+		VIKKI_CHECK_EQUAL(sample_payload::count(), 4u);
+		VIKKI_CHECK_EQUAL(sample_payload::offset<0>(), 0u);
+		VIKKI_CHECK_EQUAL(sample_payload::offset<3>(), 24u);
+
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::code(0)), static_cast<int>(value_type::int64));
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::code(1)), static_cast<int>(value_type::uint64));
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::code(2)), static_cast<int>(value_type::float64));
+
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::kind(0)), static_cast<int>(field_kind::gauge));
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::kind(1)), static_cast<int>(field_kind::counter));
+		VIKKI_CHECK_EQUAL(static_cast<int>(sample_payload::kind(3)), static_cast<int>(field_kind::counter32));
+	}
+
+	void test_encode_decode()
+	{
+		char data[sample_payload::size()];
+
+		sample_payload::encode(data, -42, 1ull << 40, 0.125, 4000000000u);
+
+		int64_t delta = 0;
+		uint64_t total = 0;
+		double ratio = 0.0;
+		uint64_t packets = 0;
+
+		sample_payload::decode(data, delta, total, ratio, packets);
+
+		VIKKI_CHECK_EQUAL(delta, -42);
+		VIKKI_CHECK_EQUAL(total, 1ull << 40);
+		VIKKI_CHECK_EQUAL(ratio, 0.125);
+		VIKKI_CHECK_EQUAL(packets, 4000000000u);
+
+		// single fields are addressed in place
+		sample_payload::set<2>(data, -1.5);
+
+		VIKKI_CHECK_EQUAL(sample_payload::get<2>(data), -1.5);
+		VIKKI_CHECK_EQUAL(sample_payload::get<0>(data), -42);
+
+		double raw;
+		std::memcpy(&raw, data + 16, sizeof(raw));
+
+		VIKKI_CHECK_EQUAL(raw, -1.5);
+	}
+
+	void test_writer_reader()
+	{
+		char data[16];
+
+		payload::writer out(data);
+		out.write<uint32_t>(7);
+		out.write_bytes("abcd", 4);
+		out.write<uint64_t>(9);
+
+		VIKKI_CHECK_EQUAL(out.size(), 16u);
+
+		payload::reader in(data, out.size());
+
+		uint32_t first = 0;
+		const char *bytes = nullptr;
+		uint64_t second = 0;
+
+		VIKKI_CHECK(in.read(first));
+		VIKKI_CHECK(in.read_bytes(bytes, 4));
+		VIKKI_CHECK(in.read(second));
+
+		VIKKI_CHECK_EQUAL(first, 7u);
+		VIKKI_CHECK(std::memcmp(bytes, "abcd", 4) == 0);
+		VIKKI_CHECK_EQUAL(second, 9u);
+
+		// reading past the end fails and leaves the reader invalid
+		uint8_t extra = 0;
+
+		VIKKI_CHECK(!in.read(extra));
+		VIKKI_CHECK(!in.valid());
+
+		payload::reader truncated(data, 6);
+
+		VIKKI_CHECK(truncated.read(first));
+		VIKKI_CHECK(!truncated.read(first));
+		VIKKI_CHECK(!truncated.read_bytes(bytes, 1));
+	}
+
+	void test_schema()
+	{
+		const sensor_schema schema = payload_schema<sample_payload>();
+
+		VIKKI_CHECK_EQUAL(schema.size(), 4u);
+		VIKKI_CHECK_EQUAL(schema[1].name, "total");
+		VIKKI_CHECK(schema[1].type == value_type::uint64);
+		VIKKI_CHECK(schema[1].kind == field_kind::counter);
+		VIKKI_CHECK(schema[2].type == value_type::float64);
+		VIKKI_CHECK(schema[3].kind == field_kind::counter32);
+
+		const std::vector<value_type> layout = schema_layout(schema);
+
+		VIKKI_CHECK_EQUAL(layout.size(), 4u);
+		VIKKI_CHECK_EQUAL(layout_size(layout), sample_payload::size());
+	}
+
+	void test_parse_field()
+	{
+		sensor_field field = parse_sensor_field("queue", value_type::float64);
+
+		VIKKI_CHECK_EQUAL(field.name, "queue");
+		VIKKI_CHECK(field.type == value_type::float64);
+		VIKKI_CHECK(field.kind == field_kind::gauge);
+
+		field = parse_sensor_field("queue:int64", value_type::float64);
+
+		VIKKI_CHECK_EQUAL(field.name, "queue");
+		VIKKI_CHECK(field.type == value_type::int64);
+
+		field = parse_sensor_field("pgfault:counter", value_type::float64);
+
+		VIKKI_CHECK(field.type == value_type::uint64);
+		VIKKI_CHECK(field.kind == field_kind::counter);
+
+		field = parse_sensor_field("rx:counter32", value_type::float64);
+
+		VIKKI_CHECK(field.type == value_type::uint64);
+		VIKKI_CHECK(field.kind == field_kind::counter32);
+
+		// only the last colon separates the type
+		field = parse_sensor_field("a:b:double", value_type::uint64);
+
+		VIKKI_CHECK_EQUAL(field.name, "a:b");
+		VIKKI_CHECK(field.type == value_type::float64);
+
+		VIKKI_CHECK_THROWS(parse_sensor_field("queue:float", value_type::uint64));
+	}
+}
+
+int main()
+{
+	test_layout();
+	test_encode_decode();
+	test_writer_reader();
+	test_schema();
+	test_parse_field();
+
+	return vikki::test::result();
+}
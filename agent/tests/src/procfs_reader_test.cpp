@@ -0,0 +1,111 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "procfs_reader.h"
+#include "test.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+namespace
+{
+	using namespace vikki;
+
+	std::string temp_path()
+	{
+		char path[] = "/tmp/vikki_procfs_reader_XXXXXX";
+
+		int fd = mkstemp(path);
+		if (fd != -1)
+		{
+			close(fd);
+		}
+
+		return path;
+	}
+
+	void write_file(const std::string& path, const std::string& content)
+	{
+		std::ofstream file(path, std::ios::trunc);
+		file << content;
+	}
+
+	void test_reread()
+	{
+		const std::string path = temp_path();
+
+		write_file(path, "first\n");
+
+		procfs_reader reader(path, 64);
+
+		VIKKI_CHECK_EQUAL(std::string(reader.read()), "first\n");
+		VIKKI_CHECK_EQUAL(reader.size(), 6u);
+
+		// the descriptor is kept open and every read starts at offset zero
+		write_file(path, "second\n");
+
+		VIKKI_CHECK_EQUAL(std::string(reader.read()), "second\n");
+		VIKKI_CHECK_EQUAL(reader.size(), 7u);
+
+		unlink(path.c_str());
+	}
+
+	void test_grow()
+	{
+		const std::string path = temp_path();
+		const std::string content(1000, 'x');
+
+		write_file(path, content);
+
+		// a buffer smaller than the file grows until the whole file fits
+		procfs_reader reader(path, 16);
+
+		VIKKI_CHECK_EQUAL(std::string(reader.read()), content);
+		VIKKI_CHECK_EQUAL(reader.size(), content.size());
+
+		unlink(path.c_str());
+	}
+
+	void test_missing()
+	{
+		procfs_reader reader("/nonexistent/vikki/file");
+
+		VIKKI_CHECK_THROWS(reader.read());
+		VIKKI_CHECK_EQUAL(reader.path(), "/nonexistent/vikki/file");
+	}
+}
+
+int main()
+{
+	test_reread();
+	test_grow();
+	test_missing();
+
+	return vikki::test::result();
+}
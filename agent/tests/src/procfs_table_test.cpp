@@ -0,0 +1,103 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "procfs_table.h"
+#include "test.h"
+
+#include <cstring>
+
+namespace
+{
+	using namespace vikki;
+
+	void test_meminfo()
+	{
+		const char data[] =
+			"MemTotal:       16384 kB\n"
+			"MemFree:         2048 kB\n"
+			"MemAvailable:    8192 kB\n"
+			"HugePages_Total:    4\n"
+			"Hugepagesize:       2 MB\n";
+
+		procfs_table table({ "MemFree", "Hugepagesize", "MemTotal", "SwapTotal", "HugePages_Total" });
+
+		uint64_t values[5];
+		values[3] = 99;
+
+		const size_t found = table.parse(data, std::strlen(data), values);
+
+		// values come back in key order whatever the line order, missing keys are zero
+		VIKKI_CHECK_EQUAL(found, 4u);
+		VIKKI_CHECK_EQUAL(values[0], 2048u * 1024);
+		VIKKI_CHECK_EQUAL(values[1], 2u * 1024 * 1024);
+		VIKKI_CHECK_EQUAL(values[2], 16384u * 1024);
+		VIKKI_CHECK_EQUAL(values[3], 0u);
+		VIKKI_CHECK_EQUAL(values[4], 4u);
+
+		VIKKI_CHECK_EQUAL(table.size(), 5u);
+		VIKKI_CHECK_EQUAL(table.key(1), "Hugepagesize");
+	}
+
+	void test_exact_keys()
+	{
+		const char data[] = "Mem: 1\nMemTotal: 2\nMemTotalX: 3";
+
+		procfs_table table({ "MemTotal" });
+
+		uint64_t value = 0;
+
+		// neither a prefix nor an extension of the key matches, and the last line needs no newline
+		VIKKI_CHECK_EQUAL(table.parse(data, std::strlen(data), &value), 1u);
+		VIKKI_CHECK_EQUAL(value, 2u);
+
+		procfs_table last({ "MemTotalX" });
+
+		VIKKI_CHECK_EQUAL(last.parse(data, std::strlen(data), &value), 1u);
+		VIKKI_CHECK_EQUAL(value, 3u);
+	}
+
+	void test_separator()
+	{
+		const char data[] = "nr_free_pages 1200\npgfault 345678\npswpin 0\n";
+
+		procfs_table table({ "pgfault", "nr_free_pages" }, ' ');
+
+		uint64_t values[2];
+
+		VIKKI_CHECK_EQUAL(table.parse(data, std::strlen(data), values), 2u);
+		VIKKI_CHECK_EQUAL(values[0], 345678u);
+		VIKKI_CHECK_EQUAL(values[1], 1200u);
+	}
+}
+
+int main()
+{
+	test_meminfo();
+	test_exact_keys();
+	test_separator();
+
+	return vikki::test::result();
+}
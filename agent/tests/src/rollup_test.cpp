@@ -0,0 +1,282 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "rollup.h"
+#include "test.h"
+
+#include <cstring>
+
+namespace
+{
+	using namespace vikki;
+
+	const std::vector<value_type> layout { value_type::uint64 };
+
+	// keeps rollup rows in memory and records purges
+	class memory_storage
+		: public storage
+	{
+	public:
+		rollup_data_t rows[2];
+		std::vector<std::pair<std::time_t, std::time_t>> purges;
+
+		std::string name() const override
+		{
+			return "memory";
+		}
+
+		void open(const std::map<std::string, std::string>& params) override
+		{
+			(void)params;
+		}
+
+		void close() override
+		{
+		}
+
+		void put_data(const std::string& sensor_name, timestamp time, const std::vector<char>& data) override
+		{
+			(void)sensor_name;
+			(void)time;
+			(void)data;
+		}
+
+		sensor_data_t get_data(const std::string& sensor_name, timestamp from, timestamp to) override
+		{
+			(void)sensor_name;
+			(void)from;
+			(void)to;
+
+			return sensor_data_t();
+		}
+
+		void put_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t time,
+			const aggregate& data) override
+		{
+			(void)sensor_name;
+
+			rows[resolution == 60 ? 0 : 1].insert(std::make_pair(time, data));
+		}
+
+		rollup_data_t get_rollup_data(const std::string& sensor_name, std::time_t resolution, std::time_t from,
+			std::time_t to) override
+		{
+			(void)sensor_name;
+
+			rollup_data_t result;
+
+			for (const std::pair<const std::time_t, aggregate>& row : rows[resolution == 60 ? 0 : 1])
+			{
+				if (row.first >= from && row.first <= to)
+				{
+					result.insert(row);
+				}
+			}
+
+			return result;
+		}
+
+		void purge_data(const std::string& sensor_name, std::time_t resolution, std::time_t before) override
+		{
+			(void)sensor_name;
+
+			purges.push_back(std::make_pair(resolution, before));
+		}
+
+		void prepare_entity(const std::string& sensor_name) override
+		{
+			(void)sensor_name;
+		}
+
+		void prepare_rollup_entity(const std::string& sensor_name, std::time_t resolution) override
+		{
+			(void)sensor_name;
+			(void)resolution;
+		}
+	};
+
+	config::rollup_info rollup_config(std::time_t raw_retention)
+	{
+		config::rollup_info info;
+
+		info.enabled = true;
+		info.raw_retention = raw_retention;
+		info.tiers.push_back(config::rollup_tier_info { 3600, 0 });
+		info.tiers.push_back(config::rollup_tier_info { 60, 86400 });
+
+		return info;
+	}
+
+	std::vector<char> pack(uint64_t value)
+	{
+		std::vector<char> data(sizeof(value));
+		std::memcpy(data.data(), &value, sizeof(value));
+
+		return data;
+	}
+
+	uint64_t unpack(const std::vector<char>& data)
+	{
+		uint64_t value;
+		std::memcpy(&value, data.data(), sizeof(value));
+
+		return value;
+	}
+
+	void test_flush_on_boundary()
+	{
+		memory_storage store;
+		rollup data(&store, rollup_config(0));
+
+		data.put_data("s", layout, 7200, pack(1));
+		data.put_data("s", layout, 7259, pack(3));
+
+		VIKKI_CHECK(store.rows[0].empty());
+
+		data.put_data("s", layout, 7260, pack(10));
+
+		VIKKI_CHECK_EQUAL(store.rows[0].size(), 1u);
+		VIKKI_CHECK_EQUAL(store.rows[0].begin()->first, 7200);
+		VIKKI_CHECK_EQUAL(store.rows[0].begin()->second.count, 2u);
+		VIKKI_CHECK_EQUAL(unpack(store.rows[0].begin()->second.avg), 2u);
+
+		// the hourly tier is still open
+		VIKKI_CHECK(store.rows[1].empty());
+
+		data.flush();
+
+		VIKKI_CHECK_EQUAL(store.rows[0].size(), 2u);
+		VIKKI_CHECK_EQUAL(store.rows[1].size(), 1u);
+		VIKKI_CHECK_EQUAL(store.rows[1].begin()->second.count, 3u);
+	}
+
+	void test_live_bucket()
+	{
+		memory_storage store;
+		rollup data(&store, rollup_config(0));
+
+		data.put_data("s", layout, 7200, pack(4));
+		data.put_data("s", layout, 7260, pack(8));
+		data.put_data("s", layout, 7270, pack(12));
+
+		std::time_t bucket = 60;
+		storage::aggregated_data_t result = data.get_aggregated_data("s", 7200, 7300, bucket, layout);
+
+		// 7260 has not been flushed to storage yet, but a range ending now must include it
+		VIKKI_CHECK_EQUAL(bucket, 60);
+		VIKKI_CHECK_EQUAL(result.size(), 2u);
+		VIKKI_CHECK_EQUAL(result[7200].count, 1u);
+		VIKKI_CHECK_EQUAL(result[7260].count, 2u);
+		VIKKI_CHECK_EQUAL(unpack(result[7260].avg), 10u);
+
+		// the live bucket lies outside this range
+		result = data.get_aggregated_data("s", 7000, 7259, bucket, layout);
+
+		VIKKI_CHECK_EQUAL(result.size(), 1u);
+		VIKKI_CHECK_EQUAL(result.count(7260), 0u);
+	}
+
+	void test_regroup()
+	{
+		memory_storage store;
+		rollup data(&store, rollup_config(0));
+
+		data.put_data("s", layout, 7200, pack(2));
+		data.put_data("s", layout, 7260, pack(4));
+		data.put_data("s", layout, 7320, pack(6));
+		data.flush();
+
+		// requested buckets are rounded up to a multiple of the tier resolution
+		std::time_t bucket = 100;
+		storage::aggregated_data_t result = data.get_aggregated_data("s", 7200, 7400, bucket, layout);
+
+		VIKKI_CHECK_EQUAL(bucket, 120);
+		VIKKI_CHECK_EQUAL(result.size(), 2u);
+		VIKKI_CHECK_EQUAL(result[7200].count, 2u);
+		VIKKI_CHECK_EQUAL(unpack(result[7200].min), 2u);
+		VIKKI_CHECK_EQUAL(unpack(result[7200].max), 4u);
+		VIKKI_CHECK_EQUAL(result[7320].count, 1u);
+	}
+
+	void test_purge()
+	{
+		memory_storage store;
+		rollup data(&store, rollup_config(0));
+
+		data.purge("s", layout, 100000);
+
+		// raw history is kept when raw retention is off, only the 60 s tier has a retention
+		VIKKI_CHECK_EQUAL(store.purges.size(), 1u);
+		VIKKI_CHECK_EQUAL(store.purges[0].first, 60);
+		VIKKI_CHECK_EQUAL(store.purges[0].second, 100000 - 86400);
+
+		memory_storage raw_store;
+		rollup raw_data(&raw_store, rollup_config(600));
+
+		raw_data.purge("s", layout, 100000);
+
+		VIKKI_CHECK_EQUAL(raw_store.purges.size(), 2u);
+		VIKKI_CHECK_EQUAL(raw_store.purges[0].first, 0);
+		VIKKI_CHECK_EQUAL(raw_store.purges[0].second, 100000 - 600);
+
+		memory_storage window_store;
+		config::rollup_info info = rollup_config(600);
+
+		info.enabled = false;
+
+		rollup window_data(&window_store, info);
+
+		window_data.prepare_window("s", 60);
+		window_data.purge("s", layout, 100000);
+
+		// disabled tiers still leave raw and window tables to purge
+		VIKKI_CHECK_EQUAL(window_store.purges.size(), 2u);
+		VIKKI_CHECK_EQUAL(window_store.purges[0].first, 0);
+		VIKKI_CHECK_EQUAL(window_store.purges[1].first, 60);
+		VIKKI_CHECK_EQUAL(window_store.purges[1].second, 100000 - 600);
+	}
+
+	void test_window_conflict()
+	{
+		memory_storage store;
+		rollup data(&store, rollup_config(0));
+
+		VIKKI_CHECK_THROWS(data.prepare_window("s", 60));
+
+		data.prepare_window("s", 300);
+	}
+}
+
+int main()
+{
+	test_flush_on_boundary();
+	test_live_bucket();
+	test_regroup();
+	test_purge();
+	test_window_conflict();
+
+	return vikki::test::result();
+}
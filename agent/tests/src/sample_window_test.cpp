@@ -0,0 +1,151 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "sample_window.h"
+#include "test.h"
+
+#include <cstring>
+
+namespace
+{
+	using namespace vikki;
+
+	const std::vector<value_type> layout { value_type::uint64, value_type::float64 };
+
+	std::vector<char> pack(uint64_t count, double ratio)
+	{
+		std::vector<char> data(16);
+
+		std::memcpy(data.data(), &count, 8);
+		std::memcpy(data.data() + 8, &ratio, 8);
+
+		return data;
+	}
+
+	template<typename T>
+	T unpack(const std::vector<char>& data, size_t offset)
+	{
+		T value;
+		std::memcpy(&value, data.data() + offset, sizeof(T));
+
+		return value;
+	}
+
+	void test_expiry()
+	{
+		sample_window window(layout, 60, 0.0);
+
+		// an empty window never expires
+		VIKKI_CHECK(window.empty());
+		VIKKI_CHECK(!window.expired(from_seconds(1000000)));
+
+		window.add(from_seconds(125) + 500000, pack(1, 0.5));
+
+		VIKKI_CHECK_EQUAL(window.start(), 120);
+		VIKKI_CHECK(!window.expired(from_seconds(179) + 999999));
+		VIKKI_CHECK(window.expired(from_seconds(180)));
+
+		window.add(from_seconds(150), pack(3, 1.5));
+
+		VIKKI_CHECK_EQUAL(window.last_time(), from_seconds(150));
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(window.last(), 0), 3u);
+
+		const aggregate value = window.result();
+
+		VIKKI_CHECK_EQUAL(value.count, 2u);
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(value.avg, 0), 2u);
+		VIKKI_CHECK_EQUAL(unpack<double>(value.avg, 8), 1.0);
+
+		window.reset();
+
+		// the next sample opens the window it falls into
+		VIKKI_CHECK(window.empty());
+
+		window.add(from_seconds(200), pack(5, 0.0));
+
+		VIKKI_CHECK_EQUAL(window.start(), 180);
+		VIKKI_CHECK_EQUAL(window.result().count, 1u);
+	}
+
+	void test_percentile()
+	{
+		sample_window window(layout, 60, 95.0);
+
+		// 20 samples, added out of order
+		for (uint64_t i = 0; i < 20; ++i)
+		{
+			const uint64_t value = (i * 7) % 20 + 1;
+
+			window.add(from_seconds(120 + static_cast<std::time_t>(i)), pack(value, value / 10.0));
+		}
+
+		// nearest rank: ceil(0.95 * 20) = 19th smallest of 1..20
+		std::vector<char> result = window.percentile();
+
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(result, 0), 19u);
+		VIKKI_CHECK_EQUAL(unpack<double>(result, 8), 1.9);
+
+		sample_window median(layout, 60, 50.0);
+
+		median.add(from_seconds(0), pack(10, 3.0));
+		median.add(from_seconds(1), pack(30, 1.0));
+		median.add(from_seconds(2), pack(20, 2.0));
+
+		// each field is ranked on its own
+		result = median.percentile();
+
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(result, 0), 20u);
+		VIKKI_CHECK_EQUAL(unpack<double>(result, 8), 2.0);
+
+		median.reset();
+
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(median.percentile(), 0), 0u);
+	}
+
+	void test_without_percentile()
+	{
+		sample_window window(layout, 60, 0.0);
+
+		window.add(from_seconds(0), pack(10, 1.0));
+
+		// no samples are kept when no percentile is asked for
+		VIKKI_CHECK_EQUAL(unpack<uint64_t>(window.percentile(), 0), 0u);
+
+		// short payloads are ignored
+		window.add(from_seconds(1), std::vector<char>(8));
+
+		VIKKI_CHECK_EQUAL(window.result().count, 1u);
+	}
+}
+
+int main()
+{
+	test_expiry();
+	test_percentile();
+	test_without_percentile();
+
+	return vikki::test::result();
+}
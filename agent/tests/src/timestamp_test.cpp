@@ -0,0 +1,101 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "timestamp.h"
+#include "test.h"
+
+#include <time.h>
+
+namespace
+{
+	using namespace vikki;
+
+	void test_conversion()
+	{
+		VIKKI_CHECK_EQUAL(from_seconds(0), 0);
+		VIKKI_CHECK_EQUAL(from_seconds(1700000000), 1700000000LL * 1000000);
+
+		VIKKI_CHECK_EQUAL(to_seconds(from_seconds(1700000000)), 1700000000);
+		VIKKI_CHECK_EQUAL(to_seconds(1700000000LL * 1000000 + 999999), 1700000000);
+
+		// before the epoch seconds round down too, so a sample always falls in the second that contains it
+		VIKKI_CHECK_EQUAL(to_seconds(-1), -1);
+		VIKKI_CHECK_EQUAL(to_seconds(-1000000), -1);
+		VIKKI_CHECK_EQUAL(to_seconds(-1000001), -2);
+	}
+
+	void test_boundaries()
+	{
+		const timestamp interval = 3 * timestamp_second;
+
+		VIKKI_CHECK_EQUAL(last_boundary(from_seconds(10), interval), from_seconds(9));
+		VIKKI_CHECK_EQUAL(next_boundary(from_seconds(10), interval), from_seconds(12));
+
+		// a time on a boundary is its own last boundary, and the next one is a full interval away
+		VIKKI_CHECK_EQUAL(last_boundary(from_seconds(12), interval), from_seconds(12));
+		VIKKI_CHECK_EQUAL(next_boundary(from_seconds(12), interval), from_seconds(15));
+
+		// fractional intervals align on microseconds of the wall clock
+		const timestamp quarter = timestamp_second / 4;
+
+		VIKKI_CHECK_EQUAL(last_boundary(from_seconds(100) + 300000, quarter), from_seconds(100) + 250000);
+		VIKKI_CHECK_EQUAL(next_boundary(from_seconds(100) + 300000, quarter), from_seconds(100) + 500000);
+
+		// every instance with the same interval samples at the same instants, whenever it started
+		VIKKI_CHECK_EQUAL(next_boundary(from_seconds(1700000041) + 123, 60 * timestamp_second),
+			next_boundary(from_seconds(1700000099), 60 * timestamp_second));
+
+		VIKKI_CHECK_EQUAL(last_boundary(-1, interval), -interval);
+		VIKKI_CHECK_EQUAL(next_boundary(-1, interval), 0);
+	}
+
+	timestamp realtime()
+	{
+		timespec value;
+		clock_gettime(CLOCK_REALTIME, &value);
+
+		return static_cast<timestamp>(value.tv_sec) * timestamp_second + value.tv_nsec / 1000;
+	}
+
+	void test_now()
+	{
+		const timestamp before = realtime();
+		const timestamp now = timestamp_now();
+		const timestamp after = realtime();
+
+		VIKKI_CHECK(now >= before);
+		VIKKI_CHECK(now <= after);
+	}
+}
+
+int main()
+{
+	test_conversion();
+	test_boundaries();
+	test_now();
+
+	return vikki::test::result();
+}
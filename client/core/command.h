@@ -34,7 +34,11 @@ namespace Vikki
 		SENSOR_DATA_SUBSCRIBE	= 0x00000000,
 		SENSOR_DATA_UPDATED		= 0x00000001,
 		GET_SENSOR_DATA			= 0x00000002,
-		GET_SENSOR_LIST			= 0x00000003
+		GET_SENSOR_LIST			= 0x00000003,
+		GET_SENSOR_AGGREGATED_DATA	= 0x00000004,
+		GET_SENSOR_SCHEMA			= 0x00000005,
+		SET_TIME_RESOLUTION			= 0x00000006,
+		GET_SENSOR_LIST_EX			= 0x00000007
 	};
 }
 
@@ -39,7 +39,9 @@ SOURCES += \
     sensor/sensor_plugin.cpp \
     sensor/sensor_dashboard.cpp \
     sensor/sensor_client_proxy.cpp \
-    sensor/sensor_dashboard_plot.cpp
+    sensor/sensor_dashboard_plot.cpp \
+    sensor/sensor_schema.cpp \
+    sensor/generic_sensor_dashboard.cpp
 
 HEADERS += \
     application.h \
@@ -58,7 +60,9 @@ HEADERS += \
     sensor/sensor_plugin.h \
     sensor/sensor_dashboard.h \
     sensor/sensor_client_proxy.h \
-    sensor/sensor_dashboard_plot.h
+    sensor/sensor_dashboard_plot.h \
+    sensor/sensor_schema.h \
+    sensor/generic_sensor_dashboard.h
 
 RESOURCES += \
     resources.qrc
@@ -29,7 +29,7 @@ SOFTWARE.
 namespace Vikki
 {
 	Client::Client()
-		: mStarted(false)
+		: mStarted(false), mTimeResolution(1)
 	{
 		qRegisterMetaType<QSslKey>("QSslKey");
 		qRegisterMetaType<QSslCertificate>("QSslCertificate");
@@ -121,9 +121,20 @@ namespace Vikki
 		return mStarted;
 	}
 
+	qint64 Client::timeResolution() const
+	{
+		return mTimeResolution;
+	}
+
+	void Client::setTimeResolution(const qint64 resolution)
+	{
+		mTimeResolution = resolution > 0 ? resolution : 1;
+	}
+
 	void Client::connected()
 	{
 		mStarted = true;
+		mTimeResolution = 1;
 
 		emit raiseConnected(mController->connection());
 
@@ -59,8 +59,12 @@ namespace Vikki
 
 		bool isStarted() const;
 
+		qint64 timeResolution() const;
+		void setTimeResolution(const qint64 resolution);
+
 	private:		
 		bool mStarted;
+		qint64 mTimeResolution;
 		ClientControllerPointer mController;
 
 	signals:
@@ -0,0 +1,198 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "generic_sensor_dashboard.h"
+
+namespace Vikki
+{
+	GenericSensorDashboard::GenericSensorDashboard(const QString& sensorName, const QString& sensorTitle)
+		: SensorDashboard(sensorName, sensorTitle), mMinY(0.0), mMaxY(0.0), mPlot(nullptr)
+	{
+	}
+
+	GenericSensorDashboard::~GenericSensorDashboard()
+	{
+	}
+
+	void GenericSensorDashboard::sensorDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<QVector<double>> values(mGraphs.count());
+
+		mMinY = 0.0;
+		mMaxY = 0.0;
+
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			double timePoint = readTimePoint(stream);
+			QVector<char> dataChunk = stream->readDataChunk();
+
+			const QVector<double>& fieldValues = mSchema.values(dataChunk);
+
+			if (fieldValues.count() != mGraphs.count())
+			{
+				continue;
+			}
+
+			time.push_back(timePoint);
+
+			for (int j = 0; j < fieldValues.count(); ++j)
+			{
+				values[j].push_back(fieldValues.at(j));
+			}
+
+			updateRanges(fieldValues);
+		}
+
+		for (int i = 0; i < mGraphs.count(); ++i)
+		{
+			mGraphs.at(i)->setData(time, values.at(i));
+		}
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			mMinY * 1.1, mMaxY * 1.1);
+	}
+
+	void GenericSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
+	{
+		double timePoint = readTimePoint(stream);
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		const QVector<double>& fieldValues = mSchema.values(dataChunk);
+
+		if (fieldValues.count() != mGraphs.count())
+		{
+			return;
+		}
+
+		double time = timePoint;
+
+		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
+		timeDiff = qAbs(timeDiff);
+
+		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
+		periodTo()->setDateTime(QDateTime::fromTime_t(time));
+
+		for (int i = 0; i < fieldValues.count(); ++i)
+		{
+			mGraphs.at(i)->addData(time, fieldValues.at(i));
+		}
+
+		updateRanges(fieldValues);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			mMinY * 1.1, mMaxY * 1.1);
+	}
+
+	void GenericSensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<QVector<double>> values(mGraphs.count());
+
+		mMinY = 0.0;
+		mMaxY = 0.0;
+
+		int64_t bucket = stream->readInt64();
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			int64_t timePoint = stream->readInt64();
+			stream->readUInt64(); // count
+
+			QVector<char> minChunk = stream->readDataChunk();
+			QVector<char> maxChunk = stream->readDataChunk();
+			QVector<char> avgChunk = stream->readDataChunk();
+
+			const QVector<double>& avgValues = mSchema.values(avgChunk);
+
+			if (avgValues.count() != mGraphs.count())
+			{
+				continue;
+			}
+
+			time.push_back(static_cast<double>(timePoint) + bucket / 2.0);
+
+			for (int j = 0; j < avgValues.count(); ++j)
+			{
+				values[j].push_back(avgValues.at(j));
+			}
+
+			updateRanges(mSchema.values(minChunk));
+			updateRanges(mSchema.values(maxChunk));
+		}
+
+		for (int i = 0; i < mGraphs.count(); ++i)
+		{
+			mGraphs.at(i)->setData(time, values.at(i));
+		}
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			mMinY * 1.1, mMaxY * 1.1);
+	}
+
+	void GenericSensorDashboard::sensorSchemaReceived(NetworkStreamInPointer stream)
+	{
+		static const QVector<QColor> colors = { Qt::green, Qt::blue, Qt::magenta, Qt::cyan, Qt::red, Qt::darkYellow, Qt::darkGreen, Qt::darkBlue };
+
+		mSchema.read(stream);
+
+		mPlot->clearGraphs();
+		mGraphs.clear();
+
+		for (int i = 0; i < mSchema.fieldCount(); ++i)
+		{
+			mGraphs.push_back(mPlot->createGraph(mSchema.field(i).name, colors.at(i % colors.count())));
+		}
+
+		refreshData();
+	}
+
+	QWidget* GenericSensorDashboard::createDashboardWidget()
+	{
+		mPlot = new SensorDashboardPlot();
+
+		emit getSensorSchema();
+
+		return mPlot;
+	}
+
+	bool GenericSensorDashboard::aggregatedDataSupported() const
+	{
+		return true;
+	}
+
+	void GenericSensorDashboard::updateRanges(const QVector<double>& values)
+	{
+		for (double value : values)
+		{
+			mMinY = value < mMinY ? value : mMinY;
+			mMaxY = value > mMaxY ? value : mMaxY;
+		}
+	}
+}
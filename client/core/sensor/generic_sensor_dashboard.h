@@ -0,0 +1,70 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_GENERIC_SENSOR_DASHBOARD_H
+#define VIKKI_GENERIC_SENSOR_DASHBOARD_H
+
+#include "sensor_dashboard.h"
+#include "sensor_dashboard_plot.h"
+#include "sensor_schema.h"
+
+#include "../plot/qcustomplot.h"
+#include "../network/network_stream_in.h"
+
+namespace Vikki
+{
+	class GenericSensorDashboard
+		: public SensorDashboard
+	{
+		Q_OBJECT
+
+	public:
+		GenericSensorDashboard(const QString& sensorName, const QString& sensorTitle);
+		~GenericSensorDashboard() override;
+
+		void sensorDataReceived(NetworkStreamInPointer stream) override;
+		void sensorDataUpdated(NetworkStreamInPointer stream) override;
+		void sensorAggregatedDataReceived(NetworkStreamInPointer stream) override;
+		void sensorSchemaReceived(NetworkStreamInPointer stream) override;
+
+	protected:
+		QWidget* createDashboardWidget() override;
+		bool aggregatedDataSupported() const override;
+
+	private:
+		SensorSchema mSchema;
+		double mMinY;
+		double mMaxY;
+		SensorDashboardPlot *mPlot;
+		QVector<QCPGraph*> mGraphs;
+
+		void updateRanges(const QVector<double>& values);
+
+	};
+}
+
+#endif // VIKKI_GENERIC_SENSOR_DASHBOARD_H
+
@@ -34,8 +34,12 @@ namespace Vikki
 		connect(mClient.data(), &Client::raiseDataReceived, this, &SensorClientProxy::clientDataReceived);
 
 		connect(mSensorDashboard, &SensorDashboard::getSensorData, this, &SensorClientProxy::getSensorData);
+		connect(mSensorDashboard, &SensorDashboard::getSensorAggregatedData, this, &SensorClientProxy::getSensorAggregatedData);
+		connect(mSensorDashboard, &SensorDashboard::getSensorSchema, this, &SensorClientProxy::getSensorSchema);
 		connect(mSensorDashboard, &SensorDashboard::subscribeSensorData, this, &SensorClientProxy::subscribeSensorData);
 
+		mSensorDashboard->setTimeResolution(mClient->timeResolution());
+
 		mSensorDashboard->create();
 	}
 
@@ -84,15 +88,53 @@ namespace Vikki
 			mSensorDashboard->showDashboardWidget();
 		};
 
+		const qint64 resolution = mClient->timeResolution();
+
+		mSensorDashboard->setTimeResolution(resolution);
+
 		NetworkStreamOutPointer stream = mClient->connection()->createStream(Command::GET_SENSOR_DATA, callback);
 
+		stream->writeString(mSensorDashboard->sensorName());
+		stream->writeInt64(static_cast<int64_t>(from) * resolution);
+		stream->writeInt64((static_cast<int64_t>(to) + 1) * resolution - 1);
+	}
+
+	void SensorClientProxy::getSensorAggregatedData(uint from, uint to, quint64 maxPoints)
+	{
+		mSensorDashboard->hideDashboardWidget();
+
+		auto callback = [this](NetworkStreamInPointer stream)
+		{
+			mSensorDashboard->sensorAggregatedDataReceived(stream);
+
+			mSensorDashboard->showDashboardWidget();
+		};
+
+		NetworkStreamOutPointer stream = mClient->connection()->createStream(Command::GET_SENSOR_AGGREGATED_DATA, callback);
+
 		stream->writeString(mSensorDashboard->sensorName());
 		stream->writeInt64(static_cast<int64_t>(from));
 		stream->writeInt64(static_cast<int64_t>(to));
+		stream->writeInt64(0);
+		stream->writeUInt64(maxPoints);
+	}
+
+	void SensorClientProxy::getSensorSchema()
+	{
+		auto callback = [this](NetworkStreamInPointer stream)
+		{
+			mSensorDashboard->sensorSchemaReceived(stream);
+		};
+
+		NetworkStreamOutPointer stream = mClient->connection()->createStream(Command::GET_SENSOR_SCHEMA, callback);
+
+		stream->writeString(mSensorDashboard->sensorName());
 	}
 
 	void SensorClientProxy::subscribeSensorData(bool subscribe)
 	{
+		mSensorDashboard->setTimeResolution(mClient->timeResolution());
+
 		NetworkStreamOutPointer stream = mClient->connection()->createStream(Command::SENSOR_DATA_SUBSCRIBE);
 
 		stream->writeString(mSensorDashboard->sensorName());
@@ -55,6 +55,8 @@ namespace Vikki
 		void clientDataReceived(NetworkConnectionPointer connection, NetworkStreamInPointer stream);
 
 		void getSensorData(uint from, uint to);
+		void getSensorAggregatedData(uint from, uint to, quint64 maxPoints);
+		void getSensorSchema();
 		void subscribeSensorData(bool subscribe);
 
 
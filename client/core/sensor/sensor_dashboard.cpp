@@ -29,7 +29,7 @@ SOFTWARE.
 namespace Vikki
 {
 	SensorDashboard::SensorDashboard(const QString& sensorName, const QString& sensorTitle)
-		: mSensorName(sensorName), mSensorTitle(sensorTitle), mDashboardWidget(nullptr)
+		: mSensorName(sensorName), mSensorTitle(sensorTitle), mTimeResolution(1), mDashboardWidget(nullptr)
 	{
 	}
 
@@ -102,6 +102,16 @@ namespace Vikki
 		return mSensorTitle;
 	}
 
+	void SensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		Q_UNUSED(stream);
+	}
+
+	void SensorDashboard::sensorSchemaReceived(NetworkStreamInPointer stream)
+	{
+		Q_UNUSED(stream);
+	}
+
 	void SensorDashboard::showDashboardWidget()
 	{
 		mDashboardWidget->setVisible(true);
@@ -114,6 +124,16 @@ namespace Vikki
 		mDummyWidget->setVisible(true);
 	}
 
+	void SensorDashboard::setTimeResolution(const qint64 resolution)
+	{
+		mTimeResolution = resolution;
+	}
+
+	double SensorDashboard::readTimePoint(NetworkStreamInPointer stream) const
+	{
+		return static_cast<double>(stream->readInt64()) / mTimeResolution;
+	}
+
 	QDateTimeEdit* SensorDashboard::periodFrom() const
 	{
 		return mPeriodFrom;
@@ -124,12 +144,31 @@ namespace Vikki
 		return mPeriodTo;
 	}
 
+	bool SensorDashboard::aggregatedDataSupported() const
+	{
+		return false;
+	}
+
+	uint SensorDashboard::dataLookback() const
+	{
+		return 0;
+	}
+
 	void SensorDashboard::refreshData()
 	{
 		uint from = mPeriodFrom->dateTime().toTime_t();
 		uint to = mPeriodTo->dateTime().toTime_t();
 
-		emit getSensorData(from, to);
+		if (aggregatedDataSupported())
+		{
+			quint64 maxPoints = static_cast<quint64>(qMax(mDashboardWidget->width(), 1000));
+
+			emit getSensorAggregatedData(from, to, maxPoints);
+
+			return;
+		}
+
+		emit getSensorData(from - qMin(from, dataLookback()), to);
 	}
 
 	void SensorDashboard::autoRefreshToggled(bool checked)
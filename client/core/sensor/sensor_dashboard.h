@@ -37,6 +37,8 @@ SOFTWARE.
 #include <QPushButton>
 #include <QGroupBox>
 
+#include <cstring>
+
 #include "../network/network_stream_in.h"
 
 namespace Vikki
@@ -58,22 +60,33 @@ namespace Vikki
 
 		virtual void sensorDataReceived(NetworkStreamInPointer stream) = 0;
 		virtual void sensorDataUpdated(NetworkStreamInPointer stream) = 0;
+		virtual void sensorAggregatedDataReceived(NetworkStreamInPointer stream);
+		virtual void sensorSchemaReceived(NetworkStreamInPointer stream);
 
 		void showDashboardWidget();
 		void hideDashboardWidget();
 
+		void setTimeResolution(const qint64 resolution);
+
 	protected:
 		template<typename T>
 		T readData(void *ptr, void **outPtr);
 
+		double readTimePoint(NetworkStreamInPointer stream) const;
+
 		QDateTimeEdit* periodFrom() const;
 		QDateTimeEdit* periodTo() const;
 
 		virtual QWidget* createDashboardWidget() = 0;
+		virtual bool aggregatedDataSupported() const;
+		virtual uint dataLookback() const;
+
+		void refreshData();
 
 	private:
 		QString mSensorName;
 		QString mSensorTitle;
+		qint64 mTimeResolution;
 
 		QDateTimeEdit *mPeriodFrom;
 		QDateTimeEdit *mPeriodTo;
@@ -84,10 +97,10 @@ namespace Vikki
 		QWidget *mDashboardWidget;
 		QWidget *mDummyWidget;
 
-		void refreshData();
-
 	signals:
 		void getSensorData(uint from, uint to);
+		void getSensorAggregatedData(uint from, uint to, quint64 maxPoints);
+		void getSensorSchema();
 		void subscribeSensorData(bool subscribe);
 
 	private slots:
@@ -99,10 +112,11 @@ namespace Vikki
 	template<typename T>
 	T SensorDashboard::readData(void *ptr, void **outPtr)
 	{
-		T *ptrT = reinterpret_cast<T*>(ptr);
-		*outPtr = ptrT + 1;
+		T value;
+		std::memcpy(&value, ptr, sizeof(T));
+		*outPtr = static_cast<char*>(ptr) + sizeof(T);
 
-		return *ptrT;
+		return value;
 	}
 }
 
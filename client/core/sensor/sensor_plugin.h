@@ -49,7 +49,7 @@ namespace Vikki
 		virtual QString title() const = 0;
 		virtual QIcon icon() const = 0;
 
-		virtual SensorDashboard* createDashboard() const = 0;
+		virtual SensorDashboard* createDashboard(const QString& sensorName) const = 0;
 
 	};
 }
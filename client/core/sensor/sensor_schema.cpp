@@ -0,0 +1,125 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "sensor_schema.h"
+
+#include <cstring>
+
+namespace Vikki
+{
+	SensorSchema::SensorSchema()
+	{
+	}
+
+	SensorSchema::~SensorSchema()
+	{
+	}
+
+	void SensorSchema::read(NetworkStreamInPointer stream)
+	{
+		mFields.clear();
+
+		quint64 fieldCount = stream->readUInt64();
+
+		for (quint64 i = 0; i < fieldCount; ++i)
+		{
+			Field field;
+
+			field.name = stream->readString();
+			field.type = static_cast<ValueType>(stream->readUInt8());
+			field.kind = static_cast<FieldKind>(stream->readUInt8());
+
+			mFields.push_back(field);
+		}
+	}
+
+	bool SensorSchema::isEmpty() const
+	{
+		return mFields.isEmpty();
+	}
+
+	int SensorSchema::fieldCount() const
+	{
+		return mFields.count();
+	}
+
+	SensorSchema::Field SensorSchema::field(int index) const
+	{
+		return mFields.at(index);
+	}
+
+	int SensorSchema::dataSize() const
+	{
+		return mFields.count() * 8;
+	}
+
+	QVector<double> SensorSchema::values(const QVector<char>& data) const
+	{
+		QVector<double> result;
+
+		if (data.count() < dataSize())
+		{
+			return result;
+		}
+
+		const char *p = data.constData();
+
+		for (const Field& field : mFields)
+		{
+			switch (field.type)
+			{
+			case VALUE_INT64:
+			{
+				qint64 value;
+				std::memcpy(&value, p, sizeof(value));
+				result.push_back(static_cast<double>(value));
+				break;
+			}
+
+			case VALUE_UINT64:
+			{
+				quint64 value;
+				std::memcpy(&value, p, sizeof(value));
+				result.push_back(static_cast<double>(value));
+				break;
+			}
+
+			case VALUE_FLOAT64:
+			{
+				double value;
+				std::memcpy(&value, p, sizeof(value));
+				result.push_back(value);
+				break;
+			}
+
+			}
+
+			p += 8;
+		}
+
+		return result;
+	}
+}
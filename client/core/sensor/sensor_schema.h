@@ -0,0 +1,80 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_SENSOR_SCHEMA_H
+#define VIKKI_SENSOR_SCHEMA_H
+
+#include <QString>
+#include <QVector>
+
+#include "../network/network_stream_in.h"
+
+namespace Vikki
+{
+	class SensorSchema
+	{
+	public:
+		enum ValueType
+		{
+			VALUE_INT64		= 0x00,
+			VALUE_UINT64	= 0x01,
+			VALUE_FLOAT64	= 0x02
+		};
+
+		enum FieldKind
+		{
+			FIELD_GAUGE		= 0x00,
+			FIELD_COUNTER	= 0x01,
+			FIELD_COUNTER32	= 0x02
+		};
+
+		struct Field
+		{
+			QString name;
+			ValueType type;
+			FieldKind kind;
+		};
+
+		SensorSchema();
+		~SensorSchema();
+
+		void read(NetworkStreamInPointer stream);
+
+		bool isEmpty() const;
+		int fieldCount() const;
+		Field field(int index) const;
+
+		int dataSize() const;
+		QVector<double> values(const QVector<char>& data) const;
+
+	private:
+		QVector<Field> mFields;
+
+	};
+}
+
+#endif // VIKKI_SENSOR_SCHEMA_H
+
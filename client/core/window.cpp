@@ -93,7 +93,9 @@ namespace Vikki
 	{
 		QSharedPointer<Client> client = createServerClient(serverData);
 
-		connect(client.data(), &Client::raiseConnected, [this, serverItem](NetworkConnectionPointer connection)
+		Client *serverClient = client.data();
+
+		connect(client.data(), &Client::raiseConnected, [this, serverItem, serverClient](NetworkConnectionPointer connection)
 		{
 			QString serverHost = serverItem->data(0, Qt::UserRole + 1).toString();
 			mServers[serverHost].active = true;
@@ -105,12 +107,21 @@ namespace Vikki
 				for (quint64 i = 0; i < sensorCount; ++i)
 				{
 					QString sensorName = stream->readString();
+					QString pluginName = stream->readString();
 
-					addServerSensor(serverItem, sensorName);
+					addServerSensor(serverItem, sensorName, pluginName);
 				}
 			};
 
-			connection->createStream(Command::GET_SENSOR_LIST, callback);
+			connection->createStream(Command::GET_SENSOR_LIST_EX, callback);
+
+			auto resolutionCallback = [serverClient](NetworkStreamInPointer stream)
+			{
+				serverClient->setTimeResolution(stream->readInt64());
+			};
+
+			NetworkStreamOutPointer resolutionStream = connection->createStream(Command::SET_TIME_RESOLUTION, resolutionCallback);
+			resolutionStream->writeInt64(1000000);
 		});
 
 		connect(client.data(), &Client::raiseDisconnected, [this, serverData, serverItem](NetworkConnectionPointer connection)
@@ -204,14 +215,9 @@ namespace Vikki
 		return client;
 	}
 
-	void Window::addServerSensor(QTreeWidgetItem *serverItem, const QString& sensorName)
+	void Window::addServerSensor(QTreeWidgetItem *serverItem, const QString& sensorName, const QString& pluginName)
 	{
-		QSharedPointer<SensorPlugin> sensor = sensorByName(sensorName);
-
-		if (sensor == nullptr)
-		{
-			return;
-		}
+		QSharedPointer<SensorPlugin> sensor = sensorByName(pluginName);
 
 		QTreeWidgetItem *sensorItem = new QTreeWidgetItem(serverItem);
 
@@ -219,11 +225,21 @@ namespace Vikki
 		sensorItemFont.setItalic(true);
 
 		sensorItem->setFont(0, sensorItemFont);
-		sensorItem->setText(0, sensor->title());
-		sensorItem->setIcon(0, sensor->icon());
+
+		if (sensor != nullptr)
+		{
+			// extra instances of a plugin are told apart by their instance name
+			sensorItem->setText(0, sensorName == pluginName ? sensor->title() : sensor->title() + " (" + sensorName + ")");
+			sensorItem->setIcon(0, sensor->icon());
+		}
+		else
+		{
+			sensorItem->setText(0, sensorName);
+		}
 
 		sensorItem->setData(0, ITEM_TYPE_ROLE, "sensor");
-		sensorItem->setData(0, SENSOR_NAME_ROLE, sensor->name());
+		sensorItem->setData(0, SENSOR_NAME_ROLE, sensorName);
+		sensorItem->setData(0, SENSOR_PLUGIN_ROLE, pluginName);
 	}
 
 	QSharedPointer<SensorPlugin> Window::sensorByName(const QString& name)
@@ -315,9 +331,10 @@ namespace Vikki
 		}
 
 		QString sensorName = current->data(0, SENSOR_NAME_ROLE).toString();
-		QSharedPointer<SensorPlugin> sensor = sensorByName(sensorName);
+		QSharedPointer<SensorPlugin> sensor = sensorByName(current->data(0, SENSOR_PLUGIN_ROLE).toString());
 
-		SensorDashboard *sensorDashboard = sensor->createDashboard();
+		SensorDashboard *sensorDashboard = sensor != nullptr ?
+			sensor->createDashboard(sensorName) : new GenericSensorDashboard(sensorName, sensorName);
 		sensorDashboard->showMaximized();
 
 		mSensorClientProxy = QSharedPointer<SensorClientProxy>(new SensorClientProxy(sensorDashboard, client));
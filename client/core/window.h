@@ -38,6 +38,7 @@ SOFTWARE.
 
 #include "sensor/sensor_plugin.h"
 #include "sensor/sensor_client_proxy.h"
+#include "sensor/generic_sensor_dashboard.h"
 
 #include <QVector>
 #include <QMap>
@@ -65,7 +66,8 @@ namespace Vikki
 		{
 			ITEM_TYPE_ROLE		= Qt::UserRole,
 			SERVER_HOST_ROLE	= Qt::UserRole + 1,
-			SENSOR_NAME_ROLE	= Qt::UserRole + 1
+			SENSOR_NAME_ROLE	= Qt::UserRole + 1,
+			SENSOR_PLUGIN_ROLE	= Qt::UserRole + 2
 		};
 
 		Window();
@@ -92,7 +94,7 @@ namespace Vikki
 
 		void prepareServer(QTreeWidgetItem *serverItem, const ServerData& serverData);
 		QSharedPointer<Client> createServerClient(const ServerData& serverData);
-		void addServerSensor(QTreeWidgetItem *serverItem, const QString& sensorName);
+		void addServerSensor(QTreeWidgetItem *serverItem, const QString& sensorName, const QString& pluginName);
 
 		QSharedPointer<SensorPlugin> sensorByName(const QString& name);
 
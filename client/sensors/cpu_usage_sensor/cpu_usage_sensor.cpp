@@ -0,0 +1,58 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "cpu_usage_sensor.h"
+
+namespace Vikki
+{
+	CpuUsageSensor::CpuUsageSensor()
+	{
+	}
+
+	CpuUsageSensor::~CpuUsageSensor()
+	{
+	}
+
+	QString CpuUsageSensor::name() const
+	{
+		return "cpu_usage";
+	}
+
+	QString CpuUsageSensor::title() const
+	{
+		return tr("CPU usage");
+	}
+
+	QIcon CpuUsageSensor::icon() const
+	{
+		return QIcon(":/icons/cpu_usage");
+	}
+
+	SensorDashboard* CpuUsageSensor::createDashboard(const QString& sensorName) const
+	{
+		return new CpuUsageSensorDashboard(sensorName, title());
+	}
+}
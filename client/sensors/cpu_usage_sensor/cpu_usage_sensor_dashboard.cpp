@@ -0,0 +1,248 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "cpu_usage_sensor_dashboard.h"
+
+#include "../../../common/include/cpu_usage_payload.h"
+
+namespace Vikki
+{
+	typedef vikki::cpu_usage_payload CpuUsagePayload;
+
+	CpuUsageSensorDashboard::CpuUsageSensorDashboard(const QString& sensorName, const QString& sensorTitle)
+		: SensorDashboard(sensorName, sensorTitle), mCpu(nullptr), mPlot(nullptr), mGraphUser(nullptr),
+		  mGraphSystem(nullptr), mGraphIoWait(nullptr), mGraphIrq(nullptr), mGraphSteal(nullptr)
+	{
+	}
+
+	CpuUsageSensorDashboard::~CpuUsageSensorDashboard()
+	{
+	}
+
+	void CpuUsageSensorDashboard::sensorDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueUser;
+		QVector<double> valueSystem;
+		QVector<double> valueIoWait;
+		QVector<double> valueIrq;
+		QVector<double> valueSteal;
+
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			double timePoint = readTimePoint(stream);
+			QVector<char> dataChunk = stream->readDataChunk();
+
+			updateCpuList(dataChunk);
+
+			CpuUsage usage;
+
+			if (!readCpuUsage(dataChunk, usage))
+			{
+				continue;
+			}
+
+			time.push_back(timePoint);
+
+			valueUser.push_back(usage.user);
+			valueSystem.push_back(usage.system);
+			valueIoWait.push_back(usage.iowait);
+			valueIrq.push_back(usage.irq);
+			valueSteal.push_back(usage.steal);
+		}
+
+		mGraphUser->setData(time, valueUser);
+		mGraphSystem->setData(time, valueSystem);
+		mGraphIoWait->setData(time, valueIoWait);
+		mGraphIrq->setData(time, valueIrq);
+		mGraphSteal->setData(time, valueSteal);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(), 0.0, 100.0);
+	}
+
+	void CpuUsageSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
+	{
+		double timePoint = readTimePoint(stream);
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		updateCpuList(dataChunk);
+
+		CpuUsage usage;
+
+		if (!readCpuUsage(dataChunk, usage))
+		{
+			return;
+		}
+
+		double time = timePoint;
+
+		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
+		timeDiff = qAbs(timeDiff);
+
+		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
+		periodTo()->setDateTime(QDateTime::fromTime_t(time));
+
+		mGraphUser->addData(time, usage.user);
+		mGraphSystem->addData(time, usage.system);
+		mGraphIoWait->addData(time, usage.iowait);
+		mGraphIrq->addData(time, usage.irq);
+		mGraphSteal->addData(time, usage.steal);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(), 0.0, 100.0);
+	}
+
+	void CpuUsageSensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueUser;
+		QVector<double> valueSystem;
+		QVector<double> valueIoWait;
+		QVector<double> valueIrq;
+		QVector<double> valueSteal;
+
+		int64_t bucket = stream->readInt64();
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			int64_t timePoint = stream->readInt64();
+			stream->readUInt64(); // count
+
+			stream->readDataChunk(); // min
+			stream->readDataChunk(); // max
+			QVector<char> avgChunk = stream->readDataChunk();
+
+			updateCpuList(avgChunk);
+
+			CpuUsage usage;
+
+			if (!readCpuUsage(avgChunk, usage))
+			{
+				continue;
+			}
+
+			time.push_back(static_cast<double>(timePoint) + bucket / 2.0);
+
+			valueUser.push_back(usage.user);
+			valueSystem.push_back(usage.system);
+			valueIoWait.push_back(usage.iowait);
+			valueIrq.push_back(usage.irq);
+			valueSteal.push_back(usage.steal);
+		}
+
+		mGraphUser->setData(time, valueUser);
+		mGraphSystem->setData(time, valueSystem);
+		mGraphIoWait->setData(time, valueIoWait);
+		mGraphIrq->setData(time, valueIrq);
+		mGraphSteal->setData(time, valueSteal);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(), 0.0, 100.0);
+	}
+
+	QWidget* CpuUsageSensorDashboard::createDashboardWidget()
+	{
+		mCpu = new QComboBox();
+		mCpu->addItem(tr("Total"));
+
+		connect(mCpu, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+			this, &CpuUsageSensorDashboard::cpuChanged);
+
+		mPlot = new SensorDashboardPlot();
+
+		mGraphUser = mPlot->createGraph(tr("User"), Qt::green);
+		mGraphSystem = mPlot->createGraph(tr("System"), Qt::red);
+		mGraphIoWait = mPlot->createGraph(tr("I/O wait"), Qt::blue);
+		mGraphIrq = mPlot->createGraph(tr("IRQ"), Qt::magenta);
+		mGraphSteal = mPlot->createGraph(tr("Steal"), Qt::darkYellow);
+
+		QHBoxLayout *cpuLayout = new QHBoxLayout();
+		cpuLayout->addWidget(new QLabel(tr("CPU")));
+		cpuLayout->addWidget(mCpu);
+		cpuLayout->addStretch();
+
+		QVBoxLayout *layout = new QVBoxLayout();
+		layout->addLayout(cpuLayout);
+		layout->addWidget(mPlot);
+
+		QWidget *widget = new QWidget();
+		widget->setLayout(layout);
+
+		return widget;
+	}
+
+	bool CpuUsageSensorDashboard::aggregatedDataSupported() const
+	{
+		return true;
+	}
+
+	void CpuUsageSensorDashboard::updateCpuList(const QVector<char>& dataChunk)
+	{
+		const int cpuCount = static_cast<int>(CpuUsagePayload::cpu_count(dataChunk.size()));
+
+		if (cpuCount < 1 || cpuCount == mCpu->count())
+		{
+			return;
+		}
+
+		mCpu->blockSignals(true);
+
+		while (mCpu->count() > cpuCount)
+		{
+			mCpu->removeItem(mCpu->count() - 1);
+		}
+
+		while (mCpu->count() < cpuCount)
+		{
+			mCpu->addItem(tr("CPU %1").arg(mCpu->count() - 1));
+		}
+
+		mCpu->blockSignals(false);
+	}
+
+	bool CpuUsageSensorDashboard::readCpuUsage(const QVector<char>& dataChunk, CpuUsage& usage) const
+	{
+		const size_t cpu = static_cast<size_t>(qMax(mCpu->currentIndex(), 0));
+
+		if (cpu >= CpuUsagePayload::cpu_count(dataChunk.size()))
+		{
+			return false;
+		}
+
+		CpuUsagePayload::decode(CpuUsagePayload::cpu(dataChunk.constData(), cpu),
+			usage.user, usage.system, usage.iowait, usage.irq, usage.steal);
+
+		return true;
+	}
+
+	void CpuUsageSensorDashboard::cpuChanged(int index)
+	{
+		Q_UNUSED(index);
+
+		refreshData();
+	}
+}
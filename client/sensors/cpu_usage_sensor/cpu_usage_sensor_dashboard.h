@@ -0,0 +1,85 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_CPU_USAGE_SENSOR_DASHBOARD_H
+#define VIKKI_CPU_USAGE_SENSOR_DASHBOARD_H
+
+#include "../../core/sensor/sensor_dashboard.h"
+#include "../../core/sensor/sensor_dashboard_plot.h"
+
+#include "../../core/plot/qcustomplot.h"
+#include "../../core/network/network_stream_in.h"
+
+#include <QComboBox>
+
+namespace Vikki
+{
+	class CpuUsageSensorDashboard
+		: public SensorDashboard
+	{
+		Q_OBJECT
+
+	public:
+		CpuUsageSensorDashboard(const QString& sensorName, const QString& sensorTitle);
+		~CpuUsageSensorDashboard() override;
+
+		void sensorDataReceived(NetworkStreamInPointer stream) override;
+		void sensorDataUpdated(NetworkStreamInPointer stream) override;
+		void sensorAggregatedDataReceived(NetworkStreamInPointer stream) override;
+
+	protected:
+		QWidget* createDashboardWidget() override;
+		bool aggregatedDataSupported() const override;
+
+	private:
+		struct CpuUsage
+		{
+			double user;
+			double system;
+			double iowait;
+			double irq;
+			double steal;
+		};
+
+		QComboBox *mCpu;
+		SensorDashboardPlot *mPlot;
+		QCPGraph *mGraphUser;
+		QCPGraph *mGraphSystem;
+		QCPGraph *mGraphIoWait;
+		QCPGraph *mGraphIrq;
+		QCPGraph *mGraphSteal;
+
+		void updateCpuList(const QVector<char>& dataChunk);
+		bool readCpuUsage(const QVector<char>& dataChunk, CpuUsage& usage) const;
+
+	private slots:
+		void cpuChanged(int index);
+
+	};
+}
+
+#endif // VIKKI_CPU_USAGE_SENSOR_DASHBOARD_H
+
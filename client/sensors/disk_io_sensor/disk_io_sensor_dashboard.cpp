@@ -0,0 +1,244 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "disk_io_sensor_dashboard.h"
+
+#include "../../../common/include/disk_io_payload.h"
+
+namespace Vikki
+{
+	typedef vikki::disk_io_payload DiskIoPayload;
+
+	DiskIoSensorDashboard::DiskIoSensorDashboard(const QString& sensorName, const QString& sensorTitle)
+		: SensorDashboard(sensorName, sensorTitle), mMaxY(0.0), mDevice(nullptr), mMetric(nullptr), mPlot(nullptr),
+		  mGraphRead(nullptr), mGraphWrite(nullptr)
+	{
+	}
+
+	DiskIoSensorDashboard::~DiskIoSensorDashboard()
+	{
+	}
+
+	void DiskIoSensorDashboard::sensorDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueRead;
+		QVector<double> valueWrite;
+
+		mMaxY = 0.0;
+
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			double timePoint = readTimePoint(stream);
+			QVector<char> dataChunk = stream->readDataChunk();
+
+			DiskIo io;
+
+			if (!readDiskIo(dataChunk, io))
+			{
+				continue;
+			}
+
+			time.push_back(timePoint);
+
+			valueRead.push_back(io.read);
+			valueWrite.push_back(io.write);
+
+			mMaxY = qMax(mMaxY, qMax(io.read, io.write));
+		}
+
+		mGraphRead->setData(time, valueRead);
+		mGraphWrite->setData(time, valueWrite);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMetric->currentIndex() == Utilization ? 100.0 : mMaxY * 1.1);
+	}
+
+	void DiskIoSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
+	{
+		double timePoint = readTimePoint(stream);
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		DiskIo io;
+
+		if (!readDiskIo(dataChunk, io))
+		{
+			return;
+		}
+
+		double time = timePoint;
+
+		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
+		timeDiff = qAbs(timeDiff);
+
+		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
+		periodTo()->setDateTime(QDateTime::fromTime_t(time));
+
+		mGraphRead->addData(time, io.read);
+		mGraphWrite->addData(time, io.write);
+
+		mMaxY = qMax(mMaxY, qMax(io.read, io.write));
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMetric->currentIndex() == Utilization ? 100.0 : mMaxY * 1.1);
+	}
+
+	QWidget* DiskIoSensorDashboard::createDashboardWidget()
+	{
+		mDevice = new QComboBox();
+
+		connect(mDevice, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+			this, &DiskIoSensorDashboard::deviceChanged);
+
+		mMetric = new QComboBox();
+		mMetric->addItem(tr("Operations, per second"));
+		mMetric->addItem(tr("Throughput, bytes/s"));
+		mMetric->addItem(tr("Average latency, ms"));
+		mMetric->addItem(tr("Utilization, %"));
+
+		connect(mMetric, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+			this, &DiskIoSensorDashboard::metricChanged);
+
+		mPlot = new SensorDashboardPlot();
+
+		mGraphRead = mPlot->createGraph(tr("Read"), Qt::green);
+		mGraphWrite = mPlot->createGraph(tr("Write"), Qt::red);
+
+		QHBoxLayout *selectorLayout = new QHBoxLayout();
+		selectorLayout->addWidget(new QLabel(tr("Device")));
+		selectorLayout->addWidget(mDevice);
+		selectorLayout->addWidget(new QLabel(tr("Metric")));
+		selectorLayout->addWidget(mMetric);
+		selectorLayout->addStretch();
+
+		QVBoxLayout *layout = new QVBoxLayout();
+		layout->addLayout(selectorLayout);
+		layout->addWidget(mPlot);
+
+		QWidget *widget = new QWidget();
+		widget->setLayout(layout);
+
+		updateGraphNames();
+
+		return widget;
+	}
+
+	bool DiskIoSensorDashboard::readDiskIo(const QVector<char>& dataChunk, DiskIo& io)
+	{
+		vikki::payload::reader in(dataChunk.constData(), static_cast<size_t>(dataChunk.size()));
+		uint32_t count = 0;
+
+		if (!DiskIoPayload::read_header(in, count))
+		{
+			return false;
+		}
+
+		bool found = false;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			std::string device;
+			const char *data = nullptr;
+
+			if (!DiskIoPayload::read_entry(in, device, data))
+			{
+				return false;
+			}
+
+			const QString deviceName = QString::fromStdString(device);
+
+			if (mDevice->findText(deviceName) < 0)
+			{
+				mDevice->blockSignals(true);
+				mDevice->addItem(deviceName);
+				mDevice->blockSignals(false);
+			}
+
+			if (found || deviceName != mDevice->currentText())
+			{
+				continue;
+			}
+
+			switch (mMetric->currentIndex())
+			{
+			case Operations:
+				io.read = DiskIoPayload::get<DiskIoPayload::reads>(data);
+				io.write = DiskIoPayload::get<DiskIoPayload::writes>(data);
+				break;
+
+			case Throughput:
+				io.read = DiskIoPayload::get<DiskIoPayload::read_bytes>(data);
+				io.write = DiskIoPayload::get<DiskIoPayload::write_bytes>(data);
+				break;
+
+			case Latency:
+				io.read = DiskIoPayload::get<DiskIoPayload::read_latency>(data);
+				io.write = DiskIoPayload::get<DiskIoPayload::write_latency>(data);
+				break;
+
+			default:
+				io.read = DiskIoPayload::get<DiskIoPayload::utilization>(data);
+				io.write = 0.0;
+				break;
+			}
+
+			found = true;
+		}
+
+		return found;
+	}
+
+	void DiskIoSensorDashboard::updateGraphNames()
+	{
+		const bool utilization = mMetric->currentIndex() == Utilization;
+
+		mGraphRead->setName(utilization ? tr("Busy") : tr("Read"));
+		mGraphWrite->setVisible(!utilization);
+		mGraphWrite->removeFromLegend();
+
+		if (!utilization)
+		{
+			mGraphWrite->addToLegend();
+		}
+	}
+
+	void DiskIoSensorDashboard::deviceChanged(int index)
+	{
+		Q_UNUSED(index);
+
+		refreshData();
+	}
+
+	void DiskIoSensorDashboard::metricChanged(int index)
+	{
+		Q_UNUSED(index);
+
+		updateGraphNames();
+		refreshData();
+	}
+}
@@ -51,9 +51,9 @@ namespace Vikki
 		return QIcon(":/icons/file_system_usage");
 	}
 
-	SensorDashboard* FileSystemUsageSensor::createDashboard() const
+	SensorDashboard* FileSystemUsageSensor::createDashboard(const QString& sensorName) const
 	{
-		return new FileSystemUsageSensorDashboard(name(), title());
+		return new FileSystemUsageSensorDashboard(sensorName, title());
 	}
 }
 
@@ -48,7 +48,7 @@ namespace Vikki
 		QString title() const override;
 		QIcon icon() const override;
 
-		SensorDashboard* createDashboard() const override;
+		SensorDashboard* createDashboard(const QString& sensorName) const override;
 
 	};
 }
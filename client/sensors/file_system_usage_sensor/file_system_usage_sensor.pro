@@ -26,6 +26,8 @@ SOURCES += \
 	file_system_usage_sensor_dashboard.cpp
 
 HEADERS += \
+	../../../common/include/payload.h \
+	../../../common/include/file_system_usage_payload.h \
 	../../core/sensor/sensor_plugin.h \
 	../../core/sensor/sensor_dashboard.h \
 	../../core/sensor/sensor_dashboard_plot.h \
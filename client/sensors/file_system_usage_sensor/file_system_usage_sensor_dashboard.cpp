@@ -26,8 +26,6 @@ SOFTWARE.
 
 #include "file_system_usage_sensor_dashboard.h"
 
-#include <cstring>
-
 namespace Vikki
 {
 	FileSystemUsageSensorDashboard::FileSystemUsageSensorDashboard(const QString& sensorName, const QString& sensorTitle)
@@ -43,24 +41,50 @@ namespace Vikki
 	{
 		uint64_t size = stream->readUInt64();
 
+		QVector<int64_t> timePoints(size);
+		QVector<QVector<char>> dataChunks(size);
+
+		mMounts.clear();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			timePoints[i] = static_cast<int64_t>(readTimePoint(stream));
+			dataChunks[i] = stream->readDataChunk();
+
+			collectMounts(dataChunks.at(i));
+		}
+
 		mTimeStampData.clear();
-		mTimeStampData.resize(size);
+
+		const int64_t from = periodFrom()->dateTime().toTime_t();
 
 		for (uint64_t i = 0; i < size; ++i)
 		{
 			TimeStampInfo info;
 
-			info.timePoint = stream->readInt64();
-			info.data = stream->readDataChunk();
+			info.timePoint = timePoints.at(i);
+
+			if (info.timePoint < from)
+			{
+				continue;
+			}
 
-			mTimeStampData[i] = info;
+			if (fileSystemUsage(dataChunks.at(i), info.usage))
+			{
+				mTimeStampData.push_back(info);
+			}
+		}
+
+		if (!dataChunks.empty())
+		{
+			retainMounts(dataChunks.last());
 		}
 
 		mTimeScale->setMaximum(mTimeStampData.count() - 1);
 		mTimeScale->setValue(mTimeStampData.count() - 1);
 
-		mTimeScale->setEnabled(size != 0);
-		mTimeStamp->setVisible(size != 0);
+		mTimeScale->setEnabled(!mTimeStampData.empty());
+		mTimeStamp->setVisible(!mTimeStampData.empty());
 
 		timeScaleMoved();
 		timeScaleReleased();
@@ -70,8 +94,17 @@ namespace Vikki
 	{
 		TimeStampInfo info;
 
-		info.timePoint = stream->readInt64();
-		info.data = stream->readDataChunk();
+		info.timePoint = static_cast<int64_t>(readTimePoint(stream));
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		collectMounts(dataChunk);
+
+		if (!fileSystemUsage(dataChunk, info.usage))
+		{
+			return;
+		}
+
+		retainMounts(dataChunk);
 
 		mTimeStampData.push_back(info);
 
@@ -119,6 +152,12 @@ namespace Vikki
 		return widget;
 	}
 
+	uint FileSystemUsageSensorDashboard::dataLookback() const
+	{
+		// samples at the start of a range reference a dictionary sent with an earlier keyframe
+		return 60 * 60;
+	}
+
 	SensorDashboardPlot* FileSystemUsageSensorDashboard::createPlot(QCPBars *&usageBar) const
 	{
 		QVector<double> usageTicks;
@@ -168,93 +207,146 @@ namespace Vikki
 		return plot;
 	}
 
-	QVector<FileSystemUsageSensorDashboard::FileSystemUsage> FileSystemUsageSensorDashboard::fileSystemUsage(const QVector<char>& data) const
+	void FileSystemUsageSensorDashboard::collectMounts(const QVector<char>& data)
 	{
-		const char *p = data.constData();
-
-		uint64_t systemCount = *reinterpret_cast<const uint64_t*>(p);
-		p += sizeof(uint64_t);
+		if (!vikki::file_system_usage_payload::is_versioned(data.constData(), data.size()))
+		{
+			return;
+		}
 
-		QVector<FileSystemUsage> fsUsage(systemCount);
+		vikki::file_system_usage_payload::sample sample;
 
-		for (uint64_t i = 0; i < systemCount; ++i)
+		if (vikki::file_system_usage_payload::decode(data.constData(), data.size(), sample) && sample.has_mounts)
 		{
-			uint64_t dirStrSize = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+			mMounts[sample.generation] = sample.mounts;
+		}
+	}
 
-			char* dirStr = new char[dirStrSize];
-			std::memcpy(dirStr, p, dirStrSize);
-			p += dirStrSize;
+	void FileSystemUsageSensorDashboard::retainMounts(const QVector<char>& data)
+	{
+		vikki::file_system_usage_payload::sample sample;
 
-			QString dir = QString::fromLocal8Bit(dirStr, dirStrSize);
+		if (!vikki::file_system_usage_payload::is_versioned(data.constData(), data.size()) ||
+			!vikki::file_system_usage_payload::decode(data.constData(), data.size(), sample))
+		{
+			return;
+		}
+
+		for (auto iter = mMounts.begin(); iter != mMounts.end(); )
+		{
+			if (iter.key() != sample.generation)
+			{
+				iter = mMounts.erase(iter);
+			}
+			else
+			{
+				++iter;
+			}
+		}
+	}
 
-			//
+	bool FileSystemUsageSensorDashboard::fileSystemUsage(const QVector<char>& data, QVector<FileSystemUsage>& fsUsage) const
+	{
+		if (!vikki::file_system_usage_payload::is_versioned(data.constData(), data.size()))
+		{
+			return legacyFileSystemUsage(data, fsUsage);
+		}
 
-			uint64_t deviceStrSize = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+		vikki::file_system_usage_payload::sample sample;
 
-			char* deviceStr = new char[deviceStrSize];
-			std::memcpy(deviceStr, p, deviceStrSize);
-			p += deviceStrSize;
+		if (!vikki::file_system_usage_payload::decode(data.constData(), data.size(), sample))
+		{
+			return false;
+		}
 
-			QString device = QString::fromLocal8Bit(deviceStr, deviceStrSize);
+		auto iter = mMounts.constFind(sample.generation);
+		if (iter == mMounts.constEnd())
+		{
+			return false;
+		}
 
-			//
+		const MountList& mounts = iter.value();
 
-			uint64_t typeStrSize = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+		fsUsage.clear();
 
-			char* typeStr = new char[typeStrSize];
-			std::memcpy(typeStr, p, typeStrSize);
-			p += typeStrSize;
+		for (const vikki::file_system_usage_payload::usage& usage : sample.usages)
+		{
+			if (usage.id >= mounts.size())
+			{
+				continue;
+			}
 
-			QString type = QString::fromLocal8Bit(typeStr, typeStrSize);
+			const vikki::file_system_usage_payload::mount& mount = mounts.at(usage.id);
 
-			//
+			FileSystemUsage fsUsageItem;
 
-			uint64_t optionsStrSize = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+			fsUsageItem.dir = QString::fromLocal8Bit(mount.dir.data(), mount.dir.size());
+			fsUsageItem.device = QString::fromLocal8Bit(mount.device.data(), mount.device.size());
+			fsUsageItem.options = QString::fromLocal8Bit(mount.options.data(), mount.options.size());
+			fsUsageItem.total = usage.total;
+			fsUsageItem.free = usage.free;
+			fsUsageItem.available = usage.avail;
+			fsUsageItem.files = usage.files;
+			fsUsageItem.freeFiles = usage.free_files;
+			fsUsageItem.stale = (usage.flags & vikki::file_system_usage_payload::stale) != 0;
+
+			fsUsage.push_back(fsUsageItem);
+		}
 
-			char* optionsStr = new char[optionsStrSize];
-			std::memcpy(optionsStr, p, optionsStrSize);
-			p += optionsStrSize;
+		return true;
+	}
 
-			QString options = QString::fromLocal8Bit(optionsStr, optionsStrSize);
+	bool FileSystemUsageSensorDashboard::legacyFileSystemUsage(const QVector<char>& data, QVector<FileSystemUsage>& fsUsage) const
+	{
+		vikki::payload::reader in(data.constData(), data.size());
 
-			//
+		auto readString = [&in](QString& value) -> bool
+		{
+			uint64_t size = 0;
+			const char *str = nullptr;
 
-			uint64_t total = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+			if (!in.read(size) || !in.read_bytes(str, size))
+			{
+				return false;
+			}
 
-			uint64_t free = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+			value = QString::fromLocal8Bit(str, size);
 
-			uint64_t available = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+			return true;
+		};
 
-			uint64_t files = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+		uint64_t systemCount = 0;
 
-			uint64_t freeFiles = *reinterpret_cast<const uint64_t*>(p);
-			p += sizeof(uint64_t);
+		if (!in.read(systemCount))
+		{
+			return false;
+		}
 
-			//
+		fsUsage.clear();
 
+		for (uint64_t i = 0; i < systemCount; ++i)
+		{
 			FileSystemUsage fsUsageItem;
+			QString type;
+
+			fsUsageItem.stale = false;
+
+			if (!readString(fsUsageItem.dir) || !readString(fsUsageItem.device) ||
+				!readString(type) || !readString(fsUsageItem.options))
+			{
+				return false;
+			}
 
-			fsUsageItem.dir = dir;
-			fsUsageItem.device = device;
-			fsUsageItem.options = options;
-			fsUsageItem.total = total;
-			fsUsageItem.free = free;
-			fsUsageItem.available = available;
-			fsUsageItem.files = files;
-			fsUsageItem.freeFiles = freeFiles;
+			if (!in.read(fsUsageItem.total) || !in.read(fsUsageItem.free) || !in.read(fsUsageItem.available) ||
+				!in.read(fsUsageItem.files) || !in.read(fsUsageItem.freeFiles))
+			{
+				return false;
+			}
 
-			fsUsage[i] = fsUsageItem;
+			fsUsage.push_back(fsUsageItem);
 		}
 
-		return fsUsage;
+		return true;
 	}
 
 	void FileSystemUsageSensorDashboard::timeScaleMoved()
@@ -298,7 +390,7 @@ namespace Vikki
 		QVector<double> spaceUsageData;
 		QVector<double> fileUsageData;
 
-		QVector<FileSystemUsage> fsUsage = fileSystemUsage(info.data);
+		const QVector<FileSystemUsage>& fsUsage = info.usage;
 
 		for (int i = 0; i < fsUsage.count(); ++i)
 		{
@@ -307,7 +399,7 @@ namespace Vikki
 			double spaceUsed = 100.0 * (fsUsageItem.total - fsUsageItem.free) / fsUsageItem.total;
 			double fileUsed = 100.0 * (fsUsageItem.files - fsUsageItem.freeFiles) / fsUsageItem.files;
 
-			spaceLabels.push_back(fsUsageItem.dir);
+			spaceLabels.push_back(fsUsageItem.stale ? fsUsageItem.dir + tr(" (stale)") : fsUsageItem.dir);
 			spaceTicks.push_back(i + 1);
 
 			spaceUsageData.push_back(spaceUsed);
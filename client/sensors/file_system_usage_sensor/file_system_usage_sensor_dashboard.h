@@ -33,6 +33,10 @@ SOFTWARE.
 #include "../../core/plot/qcustomplot.h"
 #include "../../core/network/network_stream_in.h"
 
+#include "../../../common/include/file_system_usage_payload.h"
+
+#include <QHash>
+
 namespace Vikki
 {
 	class FileSystemUsageSensorDashboard
@@ -49,6 +53,7 @@ namespace Vikki
 
 	protected:
 		QWidget* createDashboardWidget() override;
+		uint dataLookback() const override;
 
 	private:
 		struct FileSystemUsage
@@ -61,14 +66,17 @@ namespace Vikki
 			uint64_t available;
 			uint64_t files;
 			uint64_t freeFiles;
+			bool stale;
 		};
 
 		struct TimeStampInfo
 		{
 			int64_t timePoint;
-			QVector<char> data;
+			QVector<FileSystemUsage> usage;
 		};
 
+		typedef std::vector<vikki::file_system_usage_payload::mount> MountList;
+
 		SensorDashboardPlot *mSpacePlot;
 		SensorDashboardPlot *mFilePlot;
 
@@ -78,10 +86,15 @@ namespace Vikki
 		QSlider *mTimeScale;
 		QLabel *mTimeStamp;
 		QVector<TimeStampInfo> mTimeStampData;
+		QHash<quint32, MountList> mMounts;
 
 		SensorDashboardPlot* createPlot(QCPBars *&usageBar) const;
 
-		QVector<FileSystemUsage> fileSystemUsage(const QVector<char>& data) const;
+		void collectMounts(const QVector<char>& data);
+		void retainMounts(const QVector<char>& data);
+
+		bool fileSystemUsage(const QVector<char>& data, QVector<FileSystemUsage>& fsUsage) const;
+		bool legacyFileSystemUsage(const QVector<char>& data, QVector<FileSystemUsage>& fsUsage) const;
 
 	private slots:
 		void timeScaleMoved();
@@ -51,8 +51,8 @@ namespace Vikki
 		return QIcon(":/icons/load_average");
 	}
 
-	SensorDashboard* LoadAverageSensor::createDashboard() const
+	SensorDashboard* LoadAverageSensor::createDashboard(const QString& sensorName) const
 	{
-		return new LoadAverageSensorDashboard(name(), title());
+		return new LoadAverageSensorDashboard(sensorName, title());
 	}
 }
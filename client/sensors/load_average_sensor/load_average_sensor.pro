@@ -26,6 +26,8 @@ SOURCES += \
 	load_average_sensor_dashboard.cpp
 
 HEADERS += \
+	../../../common/include/payload.h \
+	../../../common/include/load_average_payload.h \
 	../../core/sensor/sensor_plugin.h \
 	../../core/sensor/sensor_dashboard.h \
 	../../core/sensor/sensor_dashboard_plot.h \
@@ -26,7 +26,7 @@ SOFTWARE.
 
 #include "load_average_sensor_dashboard.h"
 
-#include <cstring>
+#include "../../../common/include/load_average_payload.h"
 
 namespace Vikki
 {
@@ -52,16 +52,18 @@ namespace Vikki
 
 		for (uint64_t i = 0; i < size; ++i)
 		{
-			int64_t timePoint = stream->readInt64();
+			double timePoint = readTimePoint(stream);
 			QVector<char> dataChunk = stream->readDataChunk();
 
-			void *ptr = dataChunk.data();
+			if (static_cast<size_t>(dataChunk.size()) < vikki::load_average_payload::size())
+			{
+				continue;
+			}
 
-			double la1 = readData<double>(ptr, &ptr);
-			double la5 = readData<double>(ptr, &ptr);
-			double la15 = readData<double>(ptr, &ptr);
+			double la1, la5, la15;
+			vikki::load_average_payload::decode(dataChunk.constData(), la1, la5, la15);
 
-			time.push_back(static_cast<double>(timePoint));
+			time.push_back(timePoint);
 
 			value1.push_back(la1);
 			value5.push_back(la5);
@@ -82,16 +84,18 @@ namespace Vikki
 
 	void LoadAverageSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
 	{
-		int64_t timePoint = stream->readInt64();
+		double timePoint = readTimePoint(stream);
 		QVector<char> dataChunk = stream->readDataChunk();
 
-		void *ptr = dataChunk.data();
+		if (static_cast<size_t>(dataChunk.size()) < vikki::load_average_payload::size())
+		{
+			return;
+		}
 
-		double la1 = readData<double>(ptr, &ptr);
-		double la5 = readData<double>(ptr, &ptr);
-		double la15 = readData<double>(ptr, &ptr);
+		double la1, la5, la15;
+		vikki::load_average_payload::decode(dataChunk.constData(), la1, la5, la15);
 
-		double time = static_cast<double>(timePoint);
+		double time = timePoint;
 
 		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
 		timeDiff = qAbs(timeDiff);
@@ -111,6 +115,58 @@ namespace Vikki
 			0.0, mMaxY * 1.1);
 	}
 
+	void LoadAverageSensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> value1;
+		QVector<double> value5;
+		QVector<double> value15;
+
+		mMaxY = 0.0;
+
+		int64_t bucket = stream->readInt64();
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			int64_t timePoint = stream->readInt64();
+			stream->readUInt64(); // count
+
+			stream->readDataChunk(); // min
+			QVector<char> maxChunk = stream->readDataChunk();
+			QVector<char> avgChunk = stream->readDataChunk();
+
+			if (static_cast<size_t>(maxChunk.size()) < vikki::load_average_payload::size() ||
+				static_cast<size_t>(avgChunk.size()) < vikki::load_average_payload::size())
+			{
+				continue;
+			}
+
+			double max1, max5, max15;
+			vikki::load_average_payload::decode(maxChunk.constData(), max1, max5, max15);
+
+			double la1, la5, la15;
+			vikki::load_average_payload::decode(avgChunk.constData(), la1, la5, la15);
+
+			time.push_back(static_cast<double>(timePoint) + bucket / 2.0);
+
+			value1.push_back(la1);
+			value5.push_back(la5);
+			value15.push_back(la15);
+
+			mMaxY = max1 > mMaxY ? max1 : mMaxY;
+			mMaxY = max5 > mMaxY ? max5 : mMaxY;
+			mMaxY = max15 > mMaxY ? max15 : mMaxY;
+		}
+
+		mGraph1m->setData(time, value1);
+		mGraph5m->setData(time, value5);
+		mGraph15m->setData(time, value15);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMaxY * 1.1);
+	}
+
 	QWidget* LoadAverageSensorDashboard::createDashboardWidget()
 	{
 		mPlot = new SensorDashboardPlot();
@@ -121,4 +177,9 @@ namespace Vikki
 
 		return mPlot;
 	}
+
+	bool LoadAverageSensorDashboard::aggregatedDataSupported() const
+	{
+		return true;
+	}
 }
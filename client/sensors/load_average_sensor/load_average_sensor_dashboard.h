@@ -46,9 +46,11 @@ namespace Vikki
 
 		void sensorDataReceived(NetworkStreamInPointer stream) override;
 		void sensorDataUpdated(NetworkStreamInPointer stream) override;
+		void sensorAggregatedDataReceived(NetworkStreamInPointer stream) override;
 
 	protected:
 		QWidget* createDashboardWidget() override;
+		bool aggregatedDataSupported() const override;
 
 	private:
 		double mMaxY;
@@ -51,8 +51,8 @@ namespace Vikki
 		return QIcon(":/icons/memory_usage");
 	}
 
-	SensorDashboard* MemoryUsageSensor::createDashboard() const
+	SensorDashboard* MemoryUsageSensor::createDashboard(const QString& sensorName) const
 	{
-		return new MemoryUsageSensorDashboard(name(), title());
+		return new MemoryUsageSensorDashboard(sensorName, title());
 	}
 }
@@ -26,10 +26,12 @@ SOFTWARE.
 
 #include "memory_usage_sensor_dashboard.h"
 
-#include <cstring>
+#include "../../../common/include/memory_usage_payload.h"
 
 namespace Vikki
 {
+	typedef vikki::memory_usage_payload MemoryUsagePayload;
+
 	MemoryUsageSensorDashboard::MemoryUsageSensorDashboard(const QString& sensorName, const QString& sensorTitle)
 		: SensorDashboard(sensorName, sensorTitle), mMaxY(0), mPlot(nullptr), mGraphMemoryTotal(nullptr),
 		  mGraphMemoryUsed(nullptr), mGraphSwapTotal(nullptr), mGraphSwapUsed(nullptr)
@@ -53,30 +55,26 @@ namespace Vikki
 
 		for (uint64_t i = 0; i < size; ++i)
 		{
-			int64_t timePoint = stream->readInt64();
+			double timePoint = readTimePoint(stream);
 			QVector<char> dataChunk = stream->readDataChunk();
 
-			void *ptr = dataChunk.data();
-
-			uint64_t memoryTotal = readData<uint64_t>(ptr, &ptr);
-			uint64_t memoryFree = readData<uint64_t>(ptr, &ptr);
-
-			readData<uint64_t>(ptr, &ptr); // memoryBuffers
-			readData<uint64_t>(ptr, &ptr); // memoryCached
+			MemoryUsage usage;
 
-			uint64_t swapTotal = readData<uint64_t>(ptr, &ptr);
-			uint64_t swapFree = readData<uint64_t>(ptr, &ptr);
+			if (!readMemoryUsage(dataChunk, usage))
+			{
+				continue;
+			}
 
-			time.push_back(static_cast<double>(timePoint));
+			time.push_back(timePoint);
 
-			valueMemoryTotal.push_back(static_cast<double>(memoryTotal) / (1024 * 1024));
-			valueMemoryUsed.push_back(static_cast<double>(memoryTotal - memoryFree) / (1024 * 1024));
+			valueMemoryTotal.push_back(static_cast<double>(usage.memoryTotal) / (1024 * 1024));
+			valueMemoryUsed.push_back(static_cast<double>(usage.memoryUsed) / (1024 * 1024));
 
-			valueSwapTotal.push_back(static_cast<double>(swapTotal) / (1024 * 1024));
-			valueSwapUsed.push_back(static_cast<double>(swapTotal - swapFree) / (1024 * 1024));
+			valueSwapTotal.push_back(static_cast<double>(usage.swapTotal) / (1024 * 1024));
+			valueSwapUsed.push_back(static_cast<double>(usage.swapUsed) / (1024 * 1024));
 
-			mMaxY = memoryTotal > mMaxY ? memoryTotal : mMaxY;
-			mMaxY = swapTotal > mMaxY ? swapTotal : mMaxY;
+			mMaxY = usage.memoryTotal > mMaxY ? usage.memoryTotal : mMaxY;
+			mMaxY = usage.swapTotal > mMaxY ? usage.swapTotal : mMaxY;
 		}
 
 		mGraphMemoryTotal->setData(time, valueMemoryTotal);
@@ -91,21 +89,17 @@ namespace Vikki
 
 	void MemoryUsageSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
 	{
-		int64_t timePoint = stream->readInt64();
+		double timePoint = readTimePoint(stream);
 		QVector<char> dataChunk = stream->readDataChunk();
 
-		void *ptr = dataChunk.data();
+		MemoryUsage usage;
 
-		uint64_t memoryTotal = readData<uint64_t>(ptr, &ptr);
-		uint64_t memoryFree = readData<uint64_t>(ptr, &ptr);
-
-		readData<uint64_t>(ptr, &ptr); // memoryBuffers
-		readData<uint64_t>(ptr, &ptr); // memoryCached
-
-		uint64_t swapTotal = readData<uint64_t>(ptr, &ptr);
-		uint64_t swapFree = readData<uint64_t>(ptr, &ptr);
+		if (!readMemoryUsage(dataChunk, usage))
+		{
+			return;
+		}
 
-		double time = static_cast<double>(timePoint);
+		double time = timePoint;
 
 		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
 		timeDiff = qAbs(timeDiff);
@@ -113,14 +107,66 @@ namespace Vikki
 		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
 		periodTo()->setDateTime(QDateTime::fromTime_t(time));
 
-		mMaxY = memoryTotal > mMaxY ? memoryTotal : mMaxY;
-		mMaxY = swapTotal > mMaxY ? swapTotal : mMaxY;
+		mMaxY = usage.memoryTotal > mMaxY ? usage.memoryTotal : mMaxY;
+		mMaxY = usage.swapTotal > mMaxY ? usage.swapTotal : mMaxY;
 
-		mGraphSwapTotal->addData(time, static_cast<double>(swapTotal) / (1024 * 1024));
-		mGraphSwapUsed->addData(time, static_cast<double>(swapTotal - swapFree) / (1024 * 1024));
+		mGraphSwapTotal->addData(time, static_cast<double>(usage.swapTotal) / (1024 * 1024));
+		mGraphSwapUsed->addData(time, static_cast<double>(usage.swapUsed) / (1024 * 1024));
 
-		mGraphMemoryTotal->addData(time, static_cast<double>(memoryTotal) / (1024 * 1024));
-		mGraphMemoryUsed->addData(time, static_cast<double>(memoryTotal - memoryFree) / (1024 * 1024));
+		mGraphMemoryTotal->addData(time, static_cast<double>(usage.memoryTotal) / (1024 * 1024));
+		mGraphMemoryUsed->addData(time, static_cast<double>(usage.memoryUsed) / (1024 * 1024));
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMaxY / (1024 * 1024) * 1.1);
+	}
+
+	void MemoryUsageSensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueMemoryTotal;
+		QVector<double> valueMemoryUsed;
+		QVector<double> valueSwapTotal;
+		QVector<double> valueSwapUsed;
+
+		mMaxY = 0.0;
+
+		int64_t bucket = stream->readInt64();
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			int64_t timePoint = stream->readInt64();
+			stream->readUInt64(); // count
+
+			stream->readDataChunk(); // min
+			QVector<char> maxChunk = stream->readDataChunk();
+			QVector<char> avgChunk = stream->readDataChunk();
+
+			MemoryUsage maxUsage;
+			MemoryUsage usage;
+
+			if (!readMemoryUsage(maxChunk, maxUsage) || !readMemoryUsage(avgChunk, usage))
+			{
+				continue;
+			}
+
+			time.push_back(static_cast<double>(timePoint) + bucket / 2.0);
+
+			valueMemoryTotal.push_back(static_cast<double>(usage.memoryTotal) / (1024 * 1024));
+			valueMemoryUsed.push_back(static_cast<double>(usage.memoryUsed) / (1024 * 1024));
+
+			valueSwapTotal.push_back(static_cast<double>(usage.swapTotal) / (1024 * 1024));
+			valueSwapUsed.push_back(static_cast<double>(usage.swapUsed) / (1024 * 1024));
+
+			mMaxY = maxUsage.memoryTotal > mMaxY ? maxUsage.memoryTotal : mMaxY;
+			mMaxY = maxUsage.swapTotal > mMaxY ? maxUsage.swapTotal : mMaxY;
+		}
+
+		mGraphMemoryTotal->setData(time, valueMemoryTotal);
+		mGraphMemoryUsed->setData(time, valueMemoryUsed);
+
+		mGraphSwapTotal->setData(time, valueSwapTotal);
+		mGraphSwapUsed->setData(time, valueSwapUsed);
 
 		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
 			0.0, mMaxY / (1024 * 1024) * 1.1);
@@ -137,5 +183,39 @@ namespace Vikki
 
 		return mPlot;
 	}
-}
 
+	bool MemoryUsageSensorDashboard::aggregatedDataSupported() const
+	{
+		return true;
+	}
+
+	bool MemoryUsageSensorDashboard::readMemoryUsage(const QVector<char>& dataChunk, MemoryUsage& usage) const
+	{
+		const size_t size = static_cast<size_t>(dataChunk.size());
+
+		if (size < MemoryUsagePayload::offset<MemoryUsagePayload::available>())
+		{
+			return false;
+		}
+
+		const char *data = dataChunk.constData();
+
+		usage.memoryTotal = MemoryUsagePayload::get<MemoryUsagePayload::total>(data);
+		usage.memoryUsed = usage.memoryTotal - MemoryUsagePayload::get<MemoryUsagePayload::free>(data);
+
+		if (size >= MemoryUsagePayload::size())
+		{
+			uint64_t memoryAvailable = MemoryUsagePayload::get<MemoryUsagePayload::available>(data);
+
+			if (memoryAvailable != 0)
+			{
+				usage.memoryUsed = usage.memoryTotal - memoryAvailable;
+			}
+		}
+
+		usage.swapTotal = MemoryUsagePayload::get<MemoryUsagePayload::swap_total>(data);
+		usage.swapUsed = usage.swapTotal - MemoryUsagePayload::get<MemoryUsagePayload::swap_free>(data);
+
+		return true;
+	}
+}
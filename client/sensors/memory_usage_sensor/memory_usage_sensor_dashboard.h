@@ -46,11 +46,21 @@ namespace Vikki
 
 		void sensorDataReceived(NetworkStreamInPointer stream) override;
 		void sensorDataUpdated(NetworkStreamInPointer stream) override;
+		void sensorAggregatedDataReceived(NetworkStreamInPointer stream) override;
 
 	protected:
 		QWidget* createDashboardWidget() override;
+		bool aggregatedDataSupported() const override;
 
 	private:
+		struct MemoryUsage
+		{
+			uint64_t memoryTotal;
+			uint64_t memoryUsed;
+			uint64_t swapTotal;
+			uint64_t swapUsed;
+		};
+
 		uint64_t mMaxY;
 		SensorDashboardPlot *mPlot;
 		QCPGraph *mGraphMemoryTotal;
@@ -58,6 +68,8 @@ namespace Vikki
 		QCPGraph *mGraphSwapTotal;
 		QCPGraph *mGraphSwapUsed;
 
+		bool readMemoryUsage(const QVector<char>& dataChunk, MemoryUsage& usage) const;
+
 	};
 }
 
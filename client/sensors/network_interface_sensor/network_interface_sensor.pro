@@ -0,0 +1,41 @@
+TEMPLATE = \
+	lib
+
+CONFIG += \
+	plugin
+
+QT += \
+	core \
+	widgets \
+	printsupport
+
+QMAKE_CXXFLAGS += \
+	-std=c++11
+
+TARGET =\
+	network_interface_sensor
+
+SOURCES += \
+	../../core/sensor/sensor_plugin.cpp \
+	../../core/sensor/sensor_dashboard.cpp \
+	../../core/sensor/sensor_dashboard_plot.cpp \
+	../../core/plot/qcustomplot.cpp \
+	../../core/network/network_stream_in.cpp \
+	../../core/network/network_stream_out.cpp \
+	network_interface_sensor.cpp \
+	network_interface_sensor_dashboard.cpp
+
+HEADERS += \
+	../../../common/include/payload.h \
+	../../../common/include/network_interface_payload.h \
+	../../core/sensor/sensor_plugin.h \
+	../../core/sensor/sensor_dashboard.h \
+	../../core/sensor/sensor_dashboard_plot.h \
+	../../core/plot/qcustomplot.h \
+	../../core/network/network_stream_in.h \
+	../../core/network/network_stream_out.h \
+	network_interface_sensor.h \
+	network_interface_sensor_dashboard.h
+
+RESOURCES += \
+    icons.qrc
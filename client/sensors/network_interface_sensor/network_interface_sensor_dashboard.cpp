@@ -0,0 +1,187 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "network_interface_sensor_dashboard.h"
+
+#include "../../../common/include/network_interface_payload.h"
+
+namespace Vikki
+{
+	typedef vikki::network_interface_payload NetworkInterfacePayload;
+
+	NetworkInterfaceSensorDashboard::NetworkInterfaceSensorDashboard(const QString& sensorName, const QString& sensorTitle)
+		: SensorDashboard(sensorName, sensorTitle), mMaxY(0.0), mInterface(nullptr), mPlot(nullptr),
+		  mGraphRx(nullptr), mGraphTx(nullptr)
+	{
+	}
+
+	NetworkInterfaceSensorDashboard::~NetworkInterfaceSensorDashboard()
+	{
+	}
+
+	void NetworkInterfaceSensorDashboard::sensorDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueRx;
+		QVector<double> valueTx;
+
+		mMaxY = 0.0;
+
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			double timePoint = readTimePoint(stream);
+			QVector<char> dataChunk = stream->readDataChunk();
+
+			InterfaceRates rates;
+
+			if (!readInterfaceRates(dataChunk, rates))
+			{
+				continue;
+			}
+
+			time.push_back(timePoint);
+
+			valueRx.push_back(rates.rxBytes);
+			valueTx.push_back(rates.txBytes);
+
+			mMaxY = qMax(mMaxY, qMax(rates.rxBytes, rates.txBytes));
+		}
+
+		mGraphRx->setData(time, valueRx);
+		mGraphTx->setData(time, valueTx);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMaxY * 1.1);
+	}
+
+	void NetworkInterfaceSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
+	{
+		double timePoint = readTimePoint(stream);
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		InterfaceRates rates;
+
+		if (!readInterfaceRates(dataChunk, rates))
+		{
+			return;
+		}
+
+		double time = timePoint;
+
+		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
+		timeDiff = qAbs(timeDiff);
+
+		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
+		periodTo()->setDateTime(QDateTime::fromTime_t(time));
+
+		mGraphRx->addData(time, rates.rxBytes);
+		mGraphTx->addData(time, rates.txBytes);
+
+		mMaxY = qMax(mMaxY, qMax(rates.rxBytes, rates.txBytes));
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, mMaxY * 1.1);
+	}
+
+	QWidget* NetworkInterfaceSensorDashboard::createDashboardWidget()
+	{
+		mInterface = new QComboBox();
+
+		connect(mInterface, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+			this, &NetworkInterfaceSensorDashboard::interfaceChanged);
+
+		mPlot = new SensorDashboardPlot();
+
+		mGraphRx = mPlot->createGraph(tr("Received, bytes/s"), Qt::green);
+		mGraphTx = mPlot->createGraph(tr("Transmitted, bytes/s"), Qt::red);
+
+		QHBoxLayout *interfaceLayout = new QHBoxLayout();
+		interfaceLayout->addWidget(new QLabel(tr("Interface")));
+		interfaceLayout->addWidget(mInterface);
+		interfaceLayout->addStretch();
+
+		QVBoxLayout *layout = new QVBoxLayout();
+		layout->addLayout(interfaceLayout);
+		layout->addWidget(mPlot);
+
+		QWidget *widget = new QWidget();
+		widget->setLayout(layout);
+
+		return widget;
+	}
+
+	bool NetworkInterfaceSensorDashboard::readInterfaceRates(const QVector<char>& dataChunk, InterfaceRates& rates)
+	{
+		vikki::payload::reader in(dataChunk.constData(), static_cast<size_t>(dataChunk.size()));
+		uint32_t count = 0;
+
+		if (!NetworkInterfacePayload::read_header(in, count))
+		{
+			return false;
+		}
+
+		bool found = false;
+
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			std::string interface;
+			const char *data = nullptr;
+
+			if (!NetworkInterfacePayload::read_entry(in, interface, data))
+			{
+				return false;
+			}
+
+			const QString interfaceName = QString::fromStdString(interface);
+
+			if (mInterface->findText(interfaceName) < 0)
+			{
+				mInterface->blockSignals(true);
+				mInterface->addItem(interfaceName);
+				mInterface->blockSignals(false);
+			}
+
+			if (!found && interfaceName == mInterface->currentText())
+			{
+				rates.rxBytes = NetworkInterfacePayload::get<NetworkInterfacePayload::rx_bytes>(data);
+				rates.txBytes = NetworkInterfacePayload::get<NetworkInterfacePayload::tx_bytes>(data);
+
+				found = true;
+			}
+		}
+
+		return found;
+	}
+
+	void NetworkInterfaceSensorDashboard::interfaceChanged(int index)
+	{
+		Q_UNUSED(index);
+
+		refreshData();
+	}
+}
@@ -0,0 +1,268 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "pressure_sensor_dashboard.h"
+
+#include "../../../common/include/pressure_payload.h"
+
+namespace Vikki
+{
+	typedef vikki::pressure_payload PressurePayload;
+
+	PressureSensorDashboard::PressureSensorDashboard(const QString& sensorName, const QString& sensorTitle)
+		: SensorDashboard(sensorName, sensorTitle), mMaxY(0.0), mResource(nullptr), mPlot(nullptr),
+		  mGraphSome10(nullptr), mGraphSome60(nullptr), mGraphSome300(nullptr),
+		  mGraphFull10(nullptr), mGraphFull60(nullptr), mGraphFull300(nullptr)
+	{
+	}
+
+	PressureSensorDashboard::~PressureSensorDashboard()
+	{
+	}
+
+	void PressureSensorDashboard::sensorDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueSome10;
+		QVector<double> valueSome60;
+		QVector<double> valueSome300;
+		QVector<double> valueFull10;
+		QVector<double> valueFull60;
+		QVector<double> valueFull300;
+
+		mMaxY = 0.0;
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			double timePoint = readTimePoint(stream);
+			QVector<char> dataChunk = stream->readDataChunk();
+
+			Pressure pressure;
+
+			if (!readPressure(dataChunk, pressure))
+			{
+				continue;
+			}
+
+			time.push_back(timePoint);
+
+			valueSome10.push_back(pressure.some10);
+			valueSome60.push_back(pressure.some60);
+			valueSome300.push_back(pressure.some300);
+			valueFull10.push_back(pressure.full10);
+			valueFull60.push_back(pressure.full60);
+			valueFull300.push_back(pressure.full300);
+
+			updateMaxY(pressure);
+		}
+
+		mGraphSome10->setData(time, valueSome10);
+		mGraphSome60->setData(time, valueSome60);
+		mGraphSome300->setData(time, valueSome300);
+		mGraphFull10->setData(time, valueFull10);
+		mGraphFull60->setData(time, valueFull60);
+		mGraphFull300->setData(time, valueFull300);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, qMax(mMaxY * 1.1, 1.0));
+	}
+
+	void PressureSensorDashboard::sensorDataUpdated(NetworkStreamInPointer stream)
+	{
+		double timePoint = readTimePoint(stream);
+		QVector<char> dataChunk = stream->readDataChunk();
+
+		Pressure pressure;
+
+		if (!readPressure(dataChunk, pressure))
+		{
+			return;
+		}
+
+		double time = timePoint;
+
+		uint timeDiff = periodTo()->dateTime().toTime_t() - periodFrom()->dateTime().toTime_t();
+		timeDiff = qAbs(timeDiff);
+
+		periodFrom()->setDateTime(QDateTime::fromTime_t(time - timeDiff));
+		periodTo()->setDateTime(QDateTime::fromTime_t(time));
+
+		mGraphSome10->addData(time, pressure.some10);
+		mGraphSome60->addData(time, pressure.some60);
+		mGraphSome300->addData(time, pressure.some300);
+		mGraphFull10->addData(time, pressure.full10);
+		mGraphFull60->addData(time, pressure.full60);
+		mGraphFull300->addData(time, pressure.full300);
+
+		updateMaxY(pressure);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, qMax(mMaxY * 1.1, 1.0));
+	}
+
+	void PressureSensorDashboard::sensorAggregatedDataReceived(NetworkStreamInPointer stream)
+	{
+		QVector<double> time;
+		QVector<double> valueSome10;
+		QVector<double> valueSome60;
+		QVector<double> valueSome300;
+		QVector<double> valueFull10;
+		QVector<double> valueFull60;
+		QVector<double> valueFull300;
+
+		mMaxY = 0.0;
+
+		int64_t bucket = stream->readInt64();
+		uint64_t size = stream->readUInt64();
+
+		for (uint64_t i = 0; i < size; ++i)
+		{
+			int64_t timePoint = stream->readInt64();
+			stream->readUInt64(); // count
+
+			stream->readDataChunk(); // min
+			QVector<char> maxChunk = stream->readDataChunk();
+			QVector<char> avgChunk = stream->readDataChunk();
+
+			Pressure maxPressure;
+			Pressure pressure;
+
+			if (!readPressure(maxChunk, maxPressure) || !readPressure(avgChunk, pressure))
+			{
+				continue;
+			}
+
+			time.push_back(static_cast<double>(timePoint) + bucket / 2.0);
+
+			valueSome10.push_back(pressure.some10);
+			valueSome60.push_back(pressure.some60);
+			valueSome300.push_back(pressure.some300);
+			valueFull10.push_back(pressure.full10);
+			valueFull60.push_back(pressure.full60);
+			valueFull300.push_back(pressure.full300);
+
+			updateMaxY(maxPressure);
+		}
+
+		mGraphSome10->setData(time, valueSome10);
+		mGraphSome60->setData(time, valueSome60);
+		mGraphSome300->setData(time, valueSome300);
+		mGraphFull10->setData(time, valueFull10);
+		mGraphFull60->setData(time, valueFull60);
+		mGraphFull300->setData(time, valueFull300);
+
+		mPlot->setRanges(periodFrom()->dateTime().toTime_t(), periodTo()->dateTime().toTime_t(),
+			0.0, qMax(mMaxY * 1.1, 1.0));
+	}
+
+	QWidget* PressureSensorDashboard::createDashboardWidget()
+	{
+		mResource = new QComboBox();
+		mResource->addItem(tr("CPU"));
+		mResource->addItem(tr("Memory"));
+		mResource->addItem(tr("I/O"));
+
+		connect(mResource, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+			this, &PressureSensorDashboard::resourceChanged);
+
+		mPlot = new SensorDashboardPlot();
+
+		mGraphSome10 = mPlot->createGraph(tr("Some, 10 seconds"), Qt::green);
+		mGraphSome60 = mPlot->createGraph(tr("Some, 1 minute"), Qt::blue);
+		mGraphSome300 = mPlot->createGraph(tr("Some, 5 minutes"), Qt::magenta);
+		mGraphFull10 = mPlot->createGraph(tr("Full, 10 seconds"), Qt::red);
+		mGraphFull60 = mPlot->createGraph(tr("Full, 1 minute"), Qt::darkYellow);
+		mGraphFull300 = mPlot->createGraph(tr("Full, 5 minutes"), Qt::darkCyan);
+
+		QHBoxLayout *resourceLayout = new QHBoxLayout();
+		resourceLayout->addWidget(new QLabel(tr("Resource")));
+		resourceLayout->addWidget(mResource);
+		resourceLayout->addStretch();
+
+		QVBoxLayout *layout = new QVBoxLayout();
+		layout->addLayout(resourceLayout);
+		layout->addWidget(mPlot);
+
+		QWidget *widget = new QWidget();
+		widget->setLayout(layout);
+
+		return widget;
+	}
+
+	bool PressureSensorDashboard::aggregatedDataSupported() const
+	{
+		return true;
+	}
+
+	bool PressureSensorDashboard::readPressure(const QVector<char>& dataChunk, Pressure& pressure) const
+	{
+		if (static_cast<size_t>(dataChunk.size()) < PressurePayload::size())
+		{
+			return false;
+		}
+
+		PressurePayload::stall some;
+		PressurePayload::stall full;
+
+		switch (mResource->currentIndex())
+		{
+		case Memory:
+			PressurePayload::get_resource<PressurePayload::memory_some_avg10>(dataChunk.constData(), some, full);
+			break;
+
+		case Io:
+			PressurePayload::get_resource<PressurePayload::io_some_avg10>(dataChunk.constData(), some, full);
+			break;
+
+		default:
+			PressurePayload::get_resource<PressurePayload::cpu_some_avg10>(dataChunk.constData(), some, full);
+			break;
+		}
+
+		pressure.some10 = some.avg10;
+		pressure.some60 = some.avg60;
+		pressure.some300 = some.avg300;
+		pressure.full10 = full.avg10;
+		pressure.full60 = full.avg60;
+		pressure.full300 = full.avg300;
+
+		return true;
+	}
+
+	void PressureSensorDashboard::updateMaxY(const Pressure& pressure)
+	{
+		mMaxY = qMax(mMaxY, qMax(pressure.some10, qMax(pressure.some60, pressure.some300)));
+		mMaxY = qMax(mMaxY, qMax(pressure.full10, qMax(pressure.full60, pressure.full300)));
+	}
+
+	void PressureSensorDashboard::resourceChanged(int index)
+	{
+		Q_UNUSED(index);
+
+		refreshData();
+	}
+}
@@ -0,0 +1,95 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_PRESSURE_SENSOR_DASHBOARD_H
+#define VIKKI_PRESSURE_SENSOR_DASHBOARD_H
+
+#include "../../core/sensor/sensor_dashboard.h"
+#include "../../core/sensor/sensor_dashboard_plot.h"
+
+#include "../../core/plot/qcustomplot.h"
+#include "../../core/network/network_stream_in.h"
+
+#include <QComboBox>
+
+namespace Vikki
+{
+	class PressureSensorDashboard
+		: public SensorDashboard
+	{
+		Q_OBJECT
+
+	public:
+		PressureSensorDashboard(const QString& sensorName, const QString& sensorTitle);
+		~PressureSensorDashboard() override;
+
+		void sensorDataReceived(NetworkStreamInPointer stream) override;
+		void sensorDataUpdated(NetworkStreamInPointer stream) override;
+		void sensorAggregatedDataReceived(NetworkStreamInPointer stream) override;
+
+	protected:
+		QWidget* createDashboardWidget() override;
+		bool aggregatedDataSupported() const override;
+
+	private:
+		enum Resource
+		{
+			Cpu,
+			Memory,
+			Io
+		};
+
+		struct Pressure
+		{
+			double some10;
+			double some60;
+			double some300;
+			double full10;
+			double full60;
+			double full300;
+		};
+
+		double mMaxY;
+		QComboBox *mResource;
+		SensorDashboardPlot *mPlot;
+		QCPGraph *mGraphSome10;
+		QCPGraph *mGraphSome60;
+		QCPGraph *mGraphSome300;
+		QCPGraph *mGraphFull10;
+		QCPGraph *mGraphFull60;
+		QCPGraph *mGraphFull300;
+
+		bool readPressure(const QVector<char>& dataChunk, Pressure& pressure) const;
+		void updateMaxY(const Pressure& pressure);
+
+	private slots:
+		void resourceChanged(int index);
+
+	};
+}
+
+#endif // VIKKI_PRESSURE_SENSOR_DASHBOARD_H
+
@@ -7,4 +7,8 @@ CONFIG += \
 SUBDIRS += \
 	load_average_sensor \
 	memory_usage_sensor \
-	file_system_usage_sensor
+	file_system_usage_sensor \
+	cpu_usage_sensor \
+	network_interface_sensor \
+	disk_io_sensor \
+	pressure_sensor
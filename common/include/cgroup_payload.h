@@ -0,0 +1,121 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_CGROUP_PAYLOAD_H
+#define VIKKI_COMMON_CGROUP_PAYLOAD_H
+
+#include "payload.h"
+
+#include <string>
+
+namespace vikki
+{
+	struct cgroup_payload
+		: payload::layout<
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>>
+	{
+		enum field_index : size_t
+		{
+			cpu,
+			cpu_user,
+			cpu_system,
+			cpu_throttled,
+			memory_current,
+			memory_anon,
+			memory_file,
+			io_read_bytes,
+			io_write_bytes,
+			io_reads,
+			io_writes
+		};
+
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = { "cpu", "cpu_user", "cpu_system", "cpu_throttled",
+				"memory_current", "memory_anon", "memory_file",
+				"io_read_bytes", "io_write_bytes", "io_reads", "io_writes" };
+
+			return names[index];
+		}
+
+		static size_t header_size()
+		{
+			return sizeof(uint32_t);
+		}
+
+		static size_t entry_size(size_t path_size)
+		{
+			return sizeof(uint16_t) + path_size + cgroup_payload::size();
+		}
+
+		static void write_header(payload::writer& out, uint32_t count)
+		{
+			out.write<uint32_t>(count);
+		}
+
+		static char* write_entry(payload::writer& out, const std::string& path)
+		{
+			out.write<uint16_t>(static_cast<uint16_t>(path.size()));
+			out.write_bytes(path.data(), path.size());
+
+			return out.claim(cgroup_payload::size());
+		}
+
+		static bool read_header(payload::reader& in, uint32_t& count)
+		{
+			return in.read(count);
+		}
+
+		static bool read_entry(payload::reader& in, std::string& path, const char *&usage)
+		{
+			uint16_t path_size = 0;
+			const char *path_data = nullptr;
+
+			if (!in.read(path_size) || !in.read_bytes(path_data, path_size) ||
+				!in.read_bytes(usage, cgroup_payload::size()))
+			{
+				return false;
+			}
+
+			path.assign(path_data, path_size);
+
+			return true;
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_CGROUP_PAYLOAD_H
+
@@ -0,0 +1,252 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_FILE_SYSTEM_USAGE_PAYLOAD_H
+#define VIKKI_COMMON_FILE_SYSTEM_USAGE_PAYLOAD_H
+
+#include "payload.h"
+
+#include <string>
+#include <vector>
+
+namespace vikki
+{
+	struct file_system_usage_payload
+	{
+		enum : uint64_t
+		{
+			versioned	= 0x8000000000000000ull,
+			version		= 0x03
+		};
+
+		enum : uint8_t
+		{
+			has_mounts	= 0x01
+		};
+
+		enum : uint8_t
+		{
+			stale		= 0x01
+		};
+
+		struct mount
+		{
+			std::string dir;
+			std::string device;
+			std::string type;
+			std::string options;
+		};
+
+		struct usage
+		{
+			uint32_t id;
+			uint64_t total;
+			uint64_t free;
+			uint64_t avail;
+			uint64_t files;
+			uint64_t free_files;
+			uint8_t flags;
+		};
+
+		struct sample
+		{
+			uint32_t generation;
+			bool has_mounts;
+			std::vector<mount> mounts;
+			std::vector<usage> usages;
+		};
+
+		static bool is_versioned(const char *data, size_t size)
+		{
+			uint64_t header = 0;
+
+			payload::reader in(data, size);
+
+			return in.read(header) && (header & versioned) != 0;
+		}
+
+		static size_t size(const std::vector<mount> *mounts, size_t usage_count)
+		{
+			size_t result = sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t);
+
+			if (mounts != nullptr)
+			{
+				result += sizeof(uint32_t);
+
+				for (const mount& item : *mounts)
+				{
+					result += string_size(item.dir) + string_size(item.device) +
+						string_size(item.type) + string_size(item.options);
+				}
+			}
+
+			result += sizeof(uint32_t) + usage_count * (sizeof(uint32_t) + sizeof(uint64_t) * 5 + sizeof(uint8_t));
+
+			return result;
+		}
+
+		static void write_header(payload::writer& out, uint32_t generation, const std::vector<mount> *mounts, size_t usage_count)
+		{
+			out.write<uint64_t>(versioned | version);
+			out.write<uint32_t>(generation);
+			out.write<uint8_t>(mounts != nullptr ? has_mounts : 0);
+
+			if (mounts != nullptr)
+			{
+				out.write<uint32_t>(static_cast<uint32_t>(mounts->size()));
+
+				for (const mount& item : *mounts)
+				{
+					write_string(out, item.dir);
+					write_string(out, item.device);
+					write_string(out, item.type);
+					write_string(out, item.options);
+				}
+			}
+
+			out.write<uint32_t>(static_cast<uint32_t>(usage_count));
+		}
+
+		static void write_usage(payload::writer& out, const usage& item)
+		{
+			out.write<uint32_t>(item.id);
+			out.write<uint64_t>(item.total);
+			out.write<uint64_t>(item.free);
+			out.write<uint64_t>(item.avail);
+			out.write<uint64_t>(item.files);
+			out.write<uint64_t>(item.free_files);
+			out.write<uint8_t>(item.flags);
+		}
+
+		static bool decode(const char *data, size_t size, sample& result)
+		{
+			payload::reader in(data, size);
+
+			uint64_t header = 0;
+			uint8_t flags = 0;
+
+			if (!in.read(header) || (header & versioned) == 0 || !in.read(result.generation) || !in.read(flags))
+			{
+				return false;
+			}
+
+			const uint64_t format = header & ~static_cast<uint64_t>(versioned);
+
+			if (format != 0x02 && format != version)
+			{
+				return false;
+			}
+
+			result.has_mounts = (flags & has_mounts) != 0;
+			result.mounts.clear();
+			result.usages.clear();
+
+			if (result.has_mounts)
+			{
+				uint32_t count = 0;
+
+				if (!in.read(count))
+				{
+					return false;
+				}
+
+				for (uint32_t i = 0; i < count; ++i)
+				{
+					mount item;
+
+					if (!read_string(in, item.dir) || !read_string(in, item.device) ||
+						!read_string(in, item.type) || !read_string(in, item.options))
+					{
+						return false;
+					}
+
+					result.mounts.push_back(item);
+				}
+			}
+
+			uint32_t count = 0;
+
+			if (!in.read(count))
+			{
+				return false;
+			}
+
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				usage item;
+
+				item.flags = 0;
+
+				if (!in.read(item.id) || !in.read(item.total) || !in.read(item.free) || !in.read(item.avail) ||
+					!in.read(item.files) || !in.read(item.free_files))
+				{
+					return false;
+				}
+
+				if (format >= 0x03 && !in.read(item.flags))
+				{
+					return false;
+				}
+
+				result.usages.push_back(item);
+			}
+
+			return true;
+		}
+
+	private:
+		static size_t string_size(const std::string& value)
+		{
+			return sizeof(uint16_t) + (value.size() < 0xFFFF ? value.size() : 0xFFFF);
+		}
+
+		static void write_string(payload::writer& out, const std::string& value)
+		{
+			const uint16_t size = static_cast<uint16_t>(value.size() < 0xFFFF ? value.size() : 0xFFFF);
+
+			out.write<uint16_t>(size);
+			out.write_bytes(value.data(), size);
+		}
+
+		static bool read_string(payload::reader& in, std::string& value)
+		{
+			uint16_t size = 0;
+			const char *data = nullptr;
+
+			if (!in.read(size) || !in.read_bytes(data, size))
+			{
+				return false;
+			}
+
+			value.assign(data, size);
+
+			return true;
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_FILE_SYSTEM_USAGE_PAYLOAD_H
+
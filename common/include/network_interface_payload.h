@@ -0,0 +1,114 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_NETWORK_INTERFACE_PAYLOAD_H
+#define VIKKI_COMMON_NETWORK_INTERFACE_PAYLOAD_H
+
+#include "payload.h"
+
+#include <string>
+
+namespace vikki
+{
+	struct network_interface_payload
+		: payload::layout<
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>>
+	{
+		enum field_index : size_t
+		{
+			rx_bytes,
+			rx_packets,
+			rx_errors,
+			rx_drops,
+			tx_bytes,
+			tx_packets,
+			tx_errors,
+			tx_drops
+		};
+
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = { "rx_bytes", "rx_packets", "rx_errors", "rx_drops",
+				"tx_bytes", "tx_packets", "tx_errors", "tx_drops" };
+
+			return names[index];
+		}
+
+		static size_t header_size()
+		{
+			return sizeof(uint32_t);
+		}
+
+		static size_t entry_size(size_t name_size)
+		{
+			return sizeof(uint8_t) + name_size + network_interface_payload::size();
+		}
+
+		static void write_header(payload::writer& out, uint32_t count)
+		{
+			out.write<uint32_t>(count);
+		}
+
+		static char* write_entry(payload::writer& out, const char *interface, uint8_t name_size)
+		{
+			out.write<uint8_t>(name_size);
+			out.write_bytes(interface, name_size);
+
+			return out.claim(network_interface_payload::size());
+		}
+
+		static bool read_header(payload::reader& in, uint32_t& count)
+		{
+			return in.read(count);
+		}
+
+		static bool read_entry(payload::reader& in, std::string& interface, const char *&rates)
+		{
+			uint8_t name_size = 0;
+			const char *name_data = nullptr;
+
+			if (!in.read(name_size) || !in.read_bytes(name_data, name_size) ||
+				!in.read_bytes(rates, network_interface_payload::size()))
+			{
+				return false;
+			}
+
+			interface.assign(name_data, name_size);
+
+			return true;
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_NETWORK_INTERFACE_PAYLOAD_H
+
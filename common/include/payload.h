@@ -0,0 +1,316 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_PAYLOAD_H
+#define VIKKI_COMMON_PAYLOAD_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace vikki
+{
+	namespace payload
+	{
+		template<typename T>
+		struct value_code;
+
+		template<>
+		struct value_code<int64_t>
+			: std::integral_constant<uint8_t, 0x00>
+		{
+		};
+
+		template<>
+		struct value_code<uint64_t>
+			: std::integral_constant<uint8_t, 0x01>
+		{
+		};
+
+		template<>
+		struct value_code<double>
+			: std::integral_constant<uint8_t, 0x02>
+		{
+			static_assert(sizeof(double) == 8 && std::numeric_limits<double>::is_iec559,
+				"Payload float64 fields require IEEE 754 doubles");
+		};
+
+		template<typename T, uint8_t Kind>
+		struct field
+		{
+			typedef T value_type;
+
+			static constexpr uint8_t code()
+			{
+				return value_code<T>::value;
+			}
+
+			static constexpr uint8_t kind()
+			{
+				return Kind;
+			}
+		};
+
+		template<typename T>
+		using gauge = field<T, 0x00>;
+
+		template<typename T>
+		using counter = field<T, 0x01>;
+
+		// a counter kept by the source in 32 bits, which wraps around instead of resetting
+		template<typename T>
+		using counter32 = field<T, 0x02>;
+
+		namespace detail
+		{
+			template<size_t I, typename... Fields>
+			struct field_at;
+
+			template<typename Field, typename... Rest>
+			struct field_at<0, Field, Rest...>
+			{
+				typedef Field type;
+			};
+
+			template<size_t I, typename Field, typename... Rest>
+			struct field_at<I, Field, Rest...>
+				: field_at<I - 1, Rest...>
+			{
+			};
+
+			template<size_t I, typename... Fields>
+			struct field_offset;
+
+			template<typename Field, typename... Rest>
+			struct field_offset<0, Field, Rest...>
+				: std::integral_constant<size_t, 0>
+			{
+			};
+
+			template<size_t I, typename Field, typename... Rest>
+			struct field_offset<I, Field, Rest...>
+				: std::integral_constant<size_t, sizeof(typename Field::value_type) + field_offset<I - 1, Rest...>::value>
+			{
+			};
+
+			template<typename... Fields>
+			struct codec;
+
+			template<>
+			struct codec<>
+				: std::integral_constant<size_t, 0>
+			{
+				static void encode(char *)
+				{
+				}
+
+				static void decode(const char *)
+				{
+				}
+			};
+
+			template<typename Field, typename... Rest>
+			struct codec<Field, Rest...>
+				: std::integral_constant<size_t, sizeof(typename Field::value_type) + codec<Rest...>::value>
+			{
+				typedef typename Field::value_type value_type;
+
+				static void encode(char *p, value_type value, typename Rest::value_type... rest)
+				{
+					std::memcpy(p, &value, sizeof(value_type));
+					codec<Rest...>::encode(p + sizeof(value_type), rest...);
+				}
+
+				static void decode(const char *p, value_type& value, typename Rest::value_type&... rest)
+				{
+					std::memcpy(&value, p, sizeof(value_type));
+					codec<Rest...>::decode(p + sizeof(value_type), rest...);
+				}
+			};
+		}
+
+		template<typename... Fields>
+		struct layout
+		{
+			static_assert(sizeof...(Fields) > 0, "Payload layout must declare at least one field");
+
+			template<size_t I>
+			using value_type = typename detail::field_at<I, Fields...>::type::value_type;
+
+			static constexpr size_t count()
+			{
+				return sizeof...(Fields);
+			}
+
+			static constexpr size_t size()
+			{
+				return detail::codec<Fields...>::value;
+			}
+
+			template<size_t I>
+			static constexpr size_t offset()
+			{
+				return detail::field_offset<I, Fields...>::value;
+			}
+
+			static uint8_t code(size_t index)
+			{
+				static const uint8_t codes[] = { Fields::code()... };
+
+				return codes[index];
+			}
+
+			static uint8_t kind(size_t index)
+			{
+				static const uint8_t kinds[] = { Fields::kind()... };
+
+				return kinds[index];
+			}
+
+			template<size_t I>
+			static value_type<I> get(const void *data)
+			{
+				value_type<I> value;
+				std::memcpy(&value, static_cast<const char*>(data) + offset<I>(), sizeof(value));
+
+				return value;
+			}
+
+			template<size_t I>
+			static void set(void *data, value_type<I> value)
+			{
+				std::memcpy(static_cast<char*>(data) + offset<I>(), &value, sizeof(value));
+			}
+
+			static void encode(void *data, typename Fields::value_type... values)
+			{
+				detail::codec<Fields...>::encode(static_cast<char*>(data), values...);
+			}
+
+			static void decode(const void *data, typename Fields::value_type&... values)
+			{
+				detail::codec<Fields...>::decode(static_cast<const char*>(data), values...);
+			}
+		};
+
+		class writer
+		{
+		public:
+			explicit writer(char *data)
+				: _data(data), _size(0)
+			{
+			}
+
+			template<typename T>
+			void write(T value)
+			{
+				std::memcpy(_data + _size, &value, sizeof(T));
+				_size += sizeof(T);
+			}
+
+			void write_bytes(const void *data, size_t size)
+			{
+				std::memcpy(_data + _size, data, size);
+				_size += size;
+			}
+
+			char* claim(size_t size)
+			{
+				char *result = _data + _size;
+				_size += size;
+
+				return result;
+			}
+
+			size_t size() const
+			{
+				return _size;
+			}
+
+		private:
+			char *_data;
+			size_t _size;
+
+		};
+
+		class reader
+		{
+		public:
+			reader(const char *data, size_t size)
+				: _data(data), _size(size), _offset(0), _valid(true)
+			{
+			}
+
+			template<typename T>
+			bool read(T& value)
+			{
+				if (!_valid || _size - _offset < sizeof(T))
+				{
+					_valid = false;
+
+					return false;
+				}
+
+				std::memcpy(&value, _data + _offset, sizeof(T));
+				_offset += sizeof(T);
+
+				return true;
+			}
+
+			bool read_bytes(const char *&data, size_t size)
+			{
+				if (!_valid || _size - _offset < size)
+				{
+					_valid = false;
+
+					return false;
+				}
+
+				data = _data + _offset;
+				_offset += size;
+
+				return true;
+			}
+
+			bool valid() const
+			{
+				return _valid;
+			}
+
+		private:
+			const char *_data;
+			size_t _size;
+			size_t _offset;
+			bool _valid;
+
+		};
+	}
+}
+
+#endif // VIKKI_COMMON_PAYLOAD_H
+
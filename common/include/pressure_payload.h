@@ -0,0 +1,140 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_PRESSURE_PAYLOAD_H
+#define VIKKI_COMMON_PRESSURE_PAYLOAD_H
+
+#include "payload.h"
+
+namespace vikki
+{
+	struct pressure_payload
+		: payload::layout<
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::gauge<double>,
+			payload::counter<uint64_t>>
+	{
+		enum field_index : size_t
+		{
+			cpu_some_avg10,
+			cpu_some_avg60,
+			cpu_some_avg300,
+			cpu_some_total,
+			cpu_full_avg10,
+			cpu_full_avg60,
+			cpu_full_avg300,
+			cpu_full_total,
+			memory_some_avg10,
+			memory_some_avg60,
+			memory_some_avg300,
+			memory_some_total,
+			memory_full_avg10,
+			memory_full_avg60,
+			memory_full_avg300,
+			memory_full_total,
+			io_some_avg10,
+			io_some_avg60,
+			io_some_avg300,
+			io_some_total,
+			io_full_avg10,
+			io_full_avg60,
+			io_full_avg300,
+			io_full_total
+		};
+
+		// one line of a /proc/pressure file, totals are stall time in microseconds
+		struct stall
+		{
+			double avg10;
+			double avg60;
+			double avg300;
+			uint64_t total;
+		};
+
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = {
+				"cpu_some_avg10", "cpu_some_avg60", "cpu_some_avg300", "cpu_some_total",
+				"cpu_full_avg10", "cpu_full_avg60", "cpu_full_avg300", "cpu_full_total",
+				"memory_some_avg10", "memory_some_avg60", "memory_some_avg300", "memory_some_total",
+				"memory_full_avg10", "memory_full_avg60", "memory_full_avg300", "memory_full_total",
+				"io_some_avg10", "io_some_avg60", "io_some_avg300", "io_some_total",
+				"io_full_avg10", "io_full_avg60", "io_full_avg300", "io_full_total" };
+
+			return names[index];
+		}
+
+		template<size_t Base>
+		static void set_resource(void *data, const stall& some, const stall& full)
+		{
+			set<Base + 0>(data, some.avg10);
+			set<Base + 1>(data, some.avg60);
+			set<Base + 2>(data, some.avg300);
+			set<Base + 3>(data, some.total);
+			set<Base + 4>(data, full.avg10);
+			set<Base + 5>(data, full.avg60);
+			set<Base + 6>(data, full.avg300);
+			set<Base + 7>(data, full.total);
+		}
+
+		template<size_t Base>
+		static void get_resource(const void *data, stall& some, stall& full)
+		{
+			some.avg10 = get<Base + 0>(data);
+			some.avg60 = get<Base + 1>(data);
+			some.avg300 = get<Base + 2>(data);
+			some.total = get<Base + 3>(data);
+			full.avg10 = get<Base + 4>(data);
+			full.avg60 = get<Base + 5>(data);
+			full.avg300 = get<Base + 6>(data);
+			full.total = get<Base + 7>(data);
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_PRESSURE_PAYLOAD_H
+
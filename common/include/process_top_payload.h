@@ -0,0 +1,104 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_PROCESS_TOP_PAYLOAD_H
+#define VIKKI_COMMON_PROCESS_TOP_PAYLOAD_H
+
+#include "payload.h"
+
+#include <string>
+
+namespace vikki
+{
+	struct process_top_payload
+		: payload::layout<
+			payload::gauge<int64_t>,
+			payload::gauge<double>,
+			payload::gauge<uint64_t>>
+	{
+		enum field_index : size_t
+		{
+			pid,
+			cpu,
+			rss
+		};
+
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = { "pid", "cpu", "rss" };
+
+			return names[index];
+		}
+
+		static size_t header_size()
+		{
+			return 2 * sizeof(uint32_t);
+		}
+
+		static size_t entry_size(size_t name_size)
+		{
+			return sizeof(uint8_t) + name_size + process_top_payload::size();
+		}
+
+		static void write_header(payload::writer& out, uint32_t cpu_count, uint32_t memory_count)
+		{
+			out.write<uint32_t>(cpu_count);
+			out.write<uint32_t>(memory_count);
+		}
+
+		static char* write_entry(payload::writer& out, const char *command, uint8_t name_size)
+		{
+			out.write<uint8_t>(name_size);
+			out.write_bytes(command, name_size);
+
+			return out.claim(process_top_payload::size());
+		}
+
+		static bool read_header(payload::reader& in, uint32_t& cpu_count, uint32_t& memory_count)
+		{
+			return in.read(cpu_count) && in.read(memory_count);
+		}
+
+		static bool read_entry(payload::reader& in, std::string& command, const char *&process)
+		{
+			uint8_t name_size = 0;
+			const char *name_data = nullptr;
+
+			if (!in.read(name_size) || !in.read_bytes(name_data, name_size) ||
+				!in.read_bytes(process, process_top_payload::size()))
+			{
+				return false;
+			}
+
+			command.assign(name_data, name_size);
+
+			return true;
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_PROCESS_TOP_PAYLOAD_H
+
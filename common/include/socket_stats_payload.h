@@ -0,0 +1,85 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2016 Ievgen Polyvanyi
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef VIKKI_COMMON_SOCKET_STATS_PAYLOAD_H
+#define VIKKI_COMMON_SOCKET_STATS_PAYLOAD_H
+
+#include "payload.h"
+
+namespace vikki
+{
+	struct socket_stats_payload
+		: payload::layout<
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::gauge<uint64_t>,
+			payload::counter<uint64_t>,
+			payload::counter<uint64_t>,
+			payload::counter<uint64_t>,
+			payload::counter<uint64_t>>
+	{
+		enum field_index : size_t
+		{
+			established,
+			syn_sent,
+			syn_recv,
+			fin_wait1,
+			fin_wait2,
+			time_wait,
+			close,
+			close_wait,
+			last_ack,
+			listen,
+			closing,
+			listen_queue_max,
+			listen_overflows,
+			listen_drops,
+			retransmits,
+			out_segments
+		};
+
+		static const char* name(size_t index)
+		{
+			static const char* const names[] = { "established", "syn_sent", "syn_recv", "fin_wait1", "fin_wait2",
+				"time_wait", "close", "close_wait", "last_ack", "listen", "closing", "listen_queue_max",
+				"listen_overflows", "listen_drops", "retransmits", "out_segments" };
+
+			return names[index];
+		}
+	};
+}
+
+#endif // VIKKI_COMMON_SOCKET_STATS_PAYLOAD_H
+